@@ -0,0 +1,203 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_CHAIN_LIGHT
+#define DEF_HOA_CHAIN_LIGHT
+
+#include "Processor.hpp"
+
+namespace hoa
+{
+    //! The chain class merges a chain of processors into a single matrix.
+    /** The chain class should be used to replace a chain of linear processors of the harmonics, for example a rotation, an optimization, a widening and a regular decoding, by a single matrix. The processors are applied in the order they have been added, all of them except the last one must output the harmonics and the last one must output the number of outputs of the chain. The processors must be linear and must not have any memory, so a binaural decoder can't be used. The matrix is compiled by applying the chain to each harmonic, so it must be compiled again after changing a parameter of a processor. The chain only keeps references to the processors that must stay alive while the chain is compiled.
+     */
+    template <Dimension D, typename T> class Chain : public Processor<D, T>::Harmonics
+    {
+    private:
+        static const ulong          m_chunk = 64ul;
+        const ulong                 m_number_of_outputs;
+        vector<Processor<D, T>*>    m_processors;
+        T*                          m_matrix;
+        T*                          m_previous;
+        T*                          m_buffers;
+        T*                          m_vectors;
+        const T**                   m_inputs;
+        T**                         m_outputs;
+        bool                        m_changed;
+        bool                        m_started;
+
+        //! Performs the transition from the previous matrix to the current matrix.
+        /** The outputs of the previous matrix are faded out while the outputs of the current matrix are faded in over the vectors.
+         */
+        inline void ramp(const T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            const ulong size    = Processor<D, T>::Harmonics::getNumberOfHarmonics();
+            const T step        = T(1.) / T(frames);
+            Signal<T>::mul(size, m_number_of_outputs, frames, inputs, m_previous, outputs);
+            Signal<T>::scale(m_number_of_outputs * size, -1., m_previous);
+            Signal<T>::add(m_number_of_outputs * size, m_matrix, m_previous);
+            for(ulong i = 0; i < frames; i += m_chunk)
+            {
+                const ulong chunk = min(m_chunk, frames - i);
+                for(ulong j = 0; j < size; j++)
+                {
+                    m_inputs[j] = inputs[j] + i;
+                }
+                Signal<T>::mul(size, m_number_of_outputs, chunk, m_inputs, m_previous, m_outputs);
+                for(ulong j = 0; j < m_number_of_outputs; j++)
+                {
+                    Signal<T>::rampadd(chunk, T(i + 1) * step, step, m_outputs[j], outputs[j] + i);
+                }
+            }
+        }
+
+    public:
+
+        //! The chain constructor.
+        /**	The chain constructor allocates and initialize the member values depending on a order of decomposition and a number of outputs. The matrix is initialized to zero.
+         @param     order               The order.
+         @param     numberOfOutputs     The number of outputs, the number of harmonics if the chain doesn't decode.
+         */
+        Chain(const ulong order, const ulong numberOfOutputs) noexcept : Processor<D, T>::Harmonics(order),
+        m_number_of_outputs(numberOfOutputs),
+        m_changed(false),
+        m_started(false)
+        {
+            const ulong size = Processor<D, T>::Harmonics::getNumberOfHarmonics();
+            m_matrix    = Signal<T>::alloc(m_number_of_outputs * size);
+            m_previous  = Signal<T>::alloc(m_number_of_outputs * size);
+            m_buffers   = Signal<T>::alloc(2ul * max(size, m_number_of_outputs));
+            m_vectors   = Signal<T>::alloc(m_number_of_outputs * m_chunk);
+            m_inputs    = new const T*[size];
+            m_outputs   = new T*[m_number_of_outputs];
+            for(ulong i = 0; i < m_number_of_outputs; i++)
+            {
+                m_outputs[i] = m_vectors + i * m_chunk;
+            }
+        }
+
+        //! The chain destructor.
+        /**	The chain destructor free the memory.
+         */
+        ~Chain() noexcept
+        {
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_previous);
+            Signal<T>::free(m_buffers);
+            Signal<T>::free(m_vectors);
+            delete [] m_inputs;
+            delete [] m_outputs;
+        }
+
+        //! Retrieve the number of outputs.
+        /** Retrieve the number of outputs.
+         @return The number of outputs.
+         */
+        inline ulong getNumberOfOutputs() const noexcept
+        {
+            return m_number_of_outputs;
+        }
+
+        //! Retrieve the number of processors.
+        /** Retrieve the number of processors of the chain.
+         @return The number of processors.
+         */
+        inline ulong getNumberOfProcessors() const noexcept
+        {
+            return m_processors.size();
+        }
+
+        //! Add a processor at the end of the chain.
+        /** Add a processor at the end of the chain. The matrix must be compiled again.
+         @param processor The processor.
+         */
+        inline void add(Processor<D, T>& processor)
+        {
+            m_processors.push_back(&processor);
+        }
+
+        //! Remove all the processors of the chain.
+        /** Remove all the processors of the chain. The matrix must be compiled again.
+         */
+        inline void clear() noexcept
+        {
+            m_processors.clear();
+        }
+
+        //! Retrieve the matrix.
+        /** Retrieve the compiled matrix, the coefficients of the harmonics for each output.
+         @return The matrix.
+         */
+        inline const T* getMatrix() const noexcept
+        {
+            return m_matrix;
+        }
+
+        //! This method compiles the matrix of the chain.
+        /**	This method applies the processors to each harmonic to retrieve the coefficients of the matrix. You should use this method after changing a parameter of a processor of the chain, if the matrix changes, the next vector performs the transition from the previous matrix to the new one. This method isn't thread-safe with the processing.
+         */
+        void compile() noexcept
+        {
+            const ulong size    = Processor<D, T>::Harmonics::getNumberOfHarmonics();
+            const ulong length  = max(size, m_number_of_outputs);
+            if(!m_changed)
+            {
+                Signal<T>::copy(m_number_of_outputs * size, m_matrix, m_previous);
+            }
+            for(ulong i = 0; i < size; i++)
+            {
+                T* input    = m_buffers;
+                T* output   = m_buffers + length;
+                Signal<T>::clear(length, input);
+                input[i] = 1.;
+                for(ulong j = 0; j < m_processors.size(); j++)
+                {
+                    Signal<T>::clear(length, output);
+                    m_processors[j]->process(input, output);
+                    std::swap(input, output);
+                }
+                Signal<T>::copy(m_number_of_outputs, input, 1ul, m_matrix + i, size);
+            }
+            m_changed = memcmp(m_matrix, m_previous, m_number_of_outputs * size * sizeof(T)) != 0;
+        }
+
+        //! This method performs the processing of the chain.
+        /**	You should use this method for not-in-place processing and sample by sample. The inputs array contains the samples of the harmonics and the outputs array contains the samples of the outputs. The matrix changes without transition.
+         @param     inputs  The inputs array.
+         @param     outputs The outputs array.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
+        {
+            Signal<T>::mul(Processor<D, T>::Harmonics::getNumberOfHarmonics(), m_number_of_outputs, inputs, m_matrix, outputs);
+            m_changed = false;
+            m_started = true;
+        }
+
+        //! This method performs the processing of the chain.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the outputs. When the matrix has changed, the vectors perform the transition from the previous matrix to the new one.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(m_changed && m_started)
+            {
+                ramp(inputs, outputs, frames);
+            }
+            else
+            {
+                Signal<T>::mul(Processor<D, T>::Harmonics::getNumberOfHarmonics(), m_number_of_outputs, frames, inputs, m_matrix, outputs);
+            }
+            m_changed = false;
+            m_started = true;
+        }
+    };
+
+    template <Dimension D, typename T> const ulong Chain<D, T>::m_chunk;
+}
+
+#endif
@@ -0,0 +1,578 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_CONVOLVER_LIGHT
+#define DEF_HOA_CONVOLVER_LIGHT
+
+#include "Fft.hpp"
+
+namespace hoa
+{
+    //! The convolver class convolves a set of signals with a set of impulse responses in the frequency domain.
+    /** The convolver performs a uniformly partitioned overlap-save convolution. Each input is convolved with one impulse response per output and the results are summed for each output. The impulse responses are split into partitions of the vector size, the spectra of the partitions are computed once and the spectra of the inputs are stored in a frequency-domain delay line, so the inputs are transformed only once for all the outputs. The partitions after the last non-zero sample of an impulse response are skipped. The convolution doesn't add any latency.
+     */
+    template <typename T> class Convolver
+    {
+    private:
+        const ulong m_number_of_inputs;
+        const ulong m_number_of_outputs;
+        ulong       m_vector_size;
+        ulong       m_response_size;
+        ulong       m_fft_size;
+        ulong       m_spectrum_size;
+        ulong       m_number_of_partitions;
+        ulong       m_current;
+        Fft<T>*     m_fft;
+        T*          m_frames;
+        T*          m_spectra;
+        T*          m_responses;
+        T*          m_accumulator;
+        T*          m_buffer;
+        vector<ulong> m_counts;
+
+        void clear() noexcept
+        {
+            if(m_fft)
+            {
+                delete m_fft;
+                m_fft = nullptr;
+            }
+            m_frames        = Signal<T>::free(m_frames);
+            m_spectra       = Signal<T>::free(m_spectra);
+            m_responses     = Signal<T>::free(m_responses);
+            m_accumulator   = Signal<T>::free(m_accumulator);
+            m_buffer        = Signal<T>::free(m_buffer);
+        }
+
+    public:
+
+        //! The convolver constructor.
+        /** The convolver constructor initializes the member values depending on a number of inputs and a number of outputs. The rendering must be computed before the processing.
+         @param numberOfInputs  The number of inputs.
+         @param numberOfOutputs The number of outputs.
+         */
+        Convolver(const ulong numberOfInputs, const ulong numberOfOutputs) noexcept :
+        m_number_of_inputs(numberOfInputs),
+        m_number_of_outputs(numberOfOutputs),
+        m_vector_size(0ul),
+        m_response_size(0ul),
+        m_fft_size(0ul),
+        m_spectrum_size(0ul),
+        m_number_of_partitions(0ul),
+        m_current(0ul),
+        m_fft(nullptr),
+        m_frames(nullptr),
+        m_spectra(nullptr),
+        m_responses(nullptr),
+        m_accumulator(nullptr),
+        m_buffer(nullptr)
+        {
+            ;
+        }
+
+        //! The convolver destructor.
+        /** The convolver destructor free the memory.
+         */
+        ~Convolver() noexcept
+        {
+            clear();
+        }
+
+        //! Retrieve the number of inputs.
+        /** Retrieve the number of inputs.
+         @return The number of inputs.
+         */
+        inline ulong getNumberOfInputs() const noexcept
+        {
+            return m_number_of_inputs;
+        }
+
+        //! Retrieve the number of outputs.
+        /** Retrieve the number of outputs.
+         @return The number of outputs.
+         */
+        inline ulong getNumberOfOutputs() const noexcept
+        {
+            return m_number_of_outputs;
+        }
+
+        //! Retrieve the vector size.
+        /** Retrieve the vector size.
+         @return The vector size.
+         */
+        inline ulong getVectorSize() const noexcept
+        {
+            return m_vector_size;
+        }
+
+        //! Retrieve the number of partitions.
+        /** Retrieve the number of partitions of the impulse responses.
+         @return The number of partitions.
+         */
+        inline ulong getNumberOfPartitions() const noexcept
+        {
+            return m_number_of_partitions;
+        }
+
+        //! This method allocates the memory of the convolution.
+        /** This method allocates the memory and clears the impulse responses and the state of the convolution. The size of the transforms is the smallest power of 2 greater or equal to twice the vector size, so the vector size doesn't need to be a power of 2.
+         @param vectorsize  The vector size.
+         @param size        The maximum size of the impulse responses.
+         */
+        void computeRendering(const ulong vectorsize, const ulong size)
+        {
+            clear();
+            m_vector_size           = max(vectorsize, 1ul);
+            m_response_size         = max(size, 1ul);
+            m_number_of_partitions  = (m_response_size + m_vector_size - 1ul) / m_vector_size;
+            m_fft_size              = 2ul;
+            while(m_fft_size < m_vector_size * 2ul)
+            {
+                m_fft_size <<= 1;
+            }
+            m_fft           = new Fft<T>(m_fft_size);
+            m_spectrum_size = m_fft->getSpectrumSize();
+            m_current       = 0ul;
+            m_frames        = Signal<T>::alloc(m_number_of_inputs * m_fft_size);
+            m_spectra       = Signal<T>::alloc(m_number_of_partitions * m_number_of_inputs * m_spectrum_size);
+            m_responses     = Signal<T>::alloc(m_number_of_outputs * m_number_of_partitions * m_number_of_inputs * m_spectrum_size);
+            m_accumulator   = Signal<T>::alloc(m_spectrum_size);
+            m_buffer        = Signal<T>::alloc(m_fft_size);
+            m_counts.assign(m_number_of_outputs * m_number_of_inputs, 0ul);
+        }
+
+        //! This method sets an impulse response.
+        /** This method computes the spectra of the partitions of the impulse response that convolves an input for an output. The method should be called after computeRendering(). The response is cropped to the maximum size and its trailing zeros are ignored.
+         @param output      The index of the output.
+         @param input       The index of the input.
+         @param size        The size of the impulse response.
+         @param response    The impulse response.
+         @param increment   The increment between two samples of the impulse response.
+         */
+        void setResponse(const ulong output, const ulong input, const ulong size, const T* response, const ulong increment = 1ul)
+        {
+            ulong length = min(size, m_response_size);
+            while(length && response[(length - 1ul) * increment] == T(0.))
+            {
+                length--;
+            }
+            const T scale = T(1.) / T(m_fft_size);
+            m_counts[output * m_number_of_inputs + input] = (length + m_vector_size - 1ul) / m_vector_size;
+            for(ulong i = 0; i < m_number_of_partitions; i++)
+            {
+                T* spectrum = m_responses + ((output * m_number_of_partitions + i) * m_number_of_inputs + input) * m_spectrum_size;
+                Signal<T>::clear(m_fft_size, m_buffer);
+                for(ulong j = 0; j < m_vector_size && i * m_vector_size + j < length; j++)
+                {
+                    m_buffer[j] = response[(i * m_vector_size + j) * increment] * scale;
+                }
+                m_fft->forward(m_buffer, spectrum);
+            }
+            Signal<T>::clear(m_fft_size, m_buffer);
+        }
+
+        //! This method clears the state of the convolution.
+        /** This method clears the past inputs without changing the impulse responses.
+         */
+        void reset() noexcept
+        {
+            m_current = 0ul;
+            Signal<T>::clear(m_number_of_inputs * m_fft_size, m_frames);
+            Signal<T>::clear(m_number_of_partitions * m_number_of_inputs * m_spectrum_size, m_spectra);
+        }
+
+        //! This method pushes a vector of each input in the delay line.
+        /** This method computes the spectra of a vector of each input and stores them in the frequency-domain delay line without computing the outputs. It can be used instead of the process method when the outputs of a vector aren't needed.
+         @param inputs  The input vectors, the number of vectors must be the number of inputs.
+         */
+        inline void push(const T** inputs) noexcept
+        {
+            const ulong fsize = m_fft_size;
+            const ulong vsize = m_vector_size;
+            const ulong ssize = m_spectrum_size;
+
+            m_current = (m_current + 1ul) % m_number_of_partitions;
+            T* spectra = m_spectra + m_current * m_number_of_inputs * ssize;
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                T* frame = m_frames + i * fsize;
+                Signal<T>::move(fsize - vsize, frame + vsize, frame);
+                Signal<T>::copy(vsize, inputs[i], frame + fsize - vsize);
+                m_fft->forward(frame, spectra + i * ssize);
+            }
+        }
+
+        //! This method performs the convolution.
+        /** This method performs the convolution of a vector of each input and sums the results for each output.
+         @param inputs  The input vectors, the number of vectors must be the number of inputs.
+         @param outputs The output vectors, the number of vectors must be the number of outputs.
+         */
+        inline void process(const T** inputs, T** outputs) noexcept
+        {
+            const ulong fsize = m_fft_size;
+            const ulong vsize = m_vector_size;
+            const ulong ssize = m_spectrum_size;
+            const ulong psize = m_number_of_inputs * ssize;
+
+            push(inputs);
+            for(ulong i = 0; i < m_number_of_outputs; i++)
+            {
+                Signal<T>::clear(ssize, m_accumulator);
+                const T* responses  = m_responses + i * m_number_of_partitions * psize;
+                const ulong* counts = m_counts.data() + i * m_number_of_inputs;
+                for(ulong k = 0; k < m_number_of_inputs; k++)
+                {
+                    for(ulong j = 0; j < counts[k]; j++)
+                    {
+                        const ulong index = (m_current + m_number_of_partitions - j) % m_number_of_partitions;
+                        Signal<T>::cmuladd(ssize >> 1, m_spectra + index * psize + k * ssize, responses + j * psize + k * ssize, m_accumulator);
+                    }
+                }
+                m_fft->inverse(m_accumulator, m_buffer);
+                Signal<T>::copy(vsize, m_buffer + fsize - vsize, outputs[i]);
+            }
+        }
+
+        //! The non-uniform convolver class convolves a set of signals with a set of impulse responses using partitions of increasing sizes.
+        /** The non-uniform convolver performs the beginning of the impulse responses in the time domain and the rest with uniform convolvers whose partition sizes double, so the convolution doesn't add any latency whatever the number of samples processed at once.
+         */
+        class NonUniform;
+    };
+
+    template <typename T> class Convolver<T>::NonUniform
+    {
+    private:
+        const ulong                 m_number_of_inputs;
+        const ulong                 m_number_of_outputs;
+        ulong                       m_head_size;
+        ulong                       m_response_size;
+        ulong                       m_ring_size;
+        ulong                       m_index;
+        ulong                       m_count;
+        ulong                       m_segment;
+        ulong                       m_number_of_segments;
+        T*                          m_heads;
+        T*                          m_history;
+        T*                          m_rings;
+        T*                          m_buffer;
+        Convolver<T>*               m_head;
+        vector<const T*>            m_head_inputs;
+        vector<Convolver<T>*>       m_stages;
+        vector<ulong>               m_offsets;
+        vector<T*>                  m_fifos;
+        vector<const T*>            m_fifo_inputs;
+        vector<T*>                  m_buffer_outputs;
+        vector<ulong>               m_starts;
+
+        void clear() noexcept
+        {
+            for(ulong i = 0; i < m_stages.size(); i++)
+            {
+                delete m_stages[i];
+                Signal<T>::free(m_fifos[i]);
+            }
+            if(m_head)
+            {
+                delete m_head;
+                m_head = nullptr;
+            }
+            m_head_inputs.clear();
+            m_stages.clear();
+            m_offsets.clear();
+            m_fifos.clear();
+            m_fifo_inputs.clear();
+            m_buffer_outputs.clear();
+            m_starts.clear();
+            m_heads     = Signal<T>::free(m_heads);
+            m_history   = Signal<T>::free(m_history);
+            m_rings     = Signal<T>::free(m_rings);
+            m_buffer    = Signal<T>::free(m_buffer);
+        }
+
+        //! Performs the uniform convolutions after a complete segment of the head size.
+        /** When the samples of the segment have been convolved in the time domain, the segment is only pushed in the delay line of the head convolver so its delay line stays up to date.
+         @param direct   True if the segment has been convolved in the time domain.
+         */
+        void processSegment(const bool direct) noexcept
+        {
+            const ulong hsize = m_head_size;
+            if(direct)
+            {
+                m_head->push(m_head_inputs.data());
+            }
+            for(ulong i = 0; i < m_stages.size(); i++)
+            {
+                const ulong psize = m_stages[i]->getVectorSize();
+                const ulong ratio = psize / hsize;
+                const ulong slot  = m_segment % ratio;
+                for(ulong j = 0; j < m_number_of_inputs; j++)
+                {
+                    Signal<T>::copy(hsize, m_history + j * hsize * 2ul + hsize, m_fifos[i] + j * psize + slot * hsize);
+                }
+                if(slot == ratio - 1ul)
+                {
+                    m_stages[i]->process(m_fifo_inputs.data() + i * m_number_of_inputs, m_buffer_outputs.data());
+                    const ulong start = (m_index + m_offsets[i] - psize) % m_ring_size;
+                    const ulong first = min(psize, m_ring_size - start);
+                    for(ulong j = 0; j < m_number_of_outputs; j++)
+                    {
+                        T* ring = m_rings + j * m_ring_size;
+                        Signal<T>::add(first, m_buffer_outputs[j], ring + start);
+                        Signal<T>::add(psize - first, m_buffer_outputs[j] + first, ring);
+                    }
+                }
+            }
+            m_segment = (m_segment + 1ul) % m_number_of_segments;
+            for(ulong j = 0; j < m_number_of_inputs; j++)
+            {
+                Signal<T>::copy(hsize, m_history + j * hsize * 2ul + hsize, m_history + j * hsize * 2ul);
+            }
+        }
+
+    public:
+
+        //! The non-uniform convolver constructor.
+        /** The non-uniform convolver constructor initializes the member values depending on a number of inputs and a number of outputs. The rendering must be computed before the processing.
+         @param numberOfInputs  The number of inputs.
+         @param numberOfOutputs The number of outputs.
+         */
+        NonUniform(const ulong numberOfInputs, const ulong numberOfOutputs) noexcept :
+        m_number_of_inputs(numberOfInputs),
+        m_number_of_outputs(numberOfOutputs),
+        m_head_size(0ul),
+        m_response_size(0ul),
+        m_ring_size(0ul),
+        m_index(0ul),
+        m_count(0ul),
+        m_segment(0ul),
+        m_number_of_segments(1ul),
+        m_heads(nullptr),
+        m_history(nullptr),
+        m_rings(nullptr),
+        m_buffer(nullptr),
+        m_head(nullptr)
+        {
+            ;
+        }
+
+        //! The non-uniform convolver destructor.
+        /** The non-uniform convolver destructor free the memory.
+         */
+        ~NonUniform() noexcept
+        {
+            clear();
+        }
+
+        //! Retrieve the number of inputs.
+        /** Retrieve the number of inputs.
+         @return The number of inputs.
+         */
+        inline ulong getNumberOfInputs() const noexcept
+        {
+            return m_number_of_inputs;
+        }
+
+        //! Retrieve the number of outputs.
+        /** Retrieve the number of outputs.
+         @return The number of outputs.
+         */
+        inline ulong getNumberOfOutputs() const noexcept
+        {
+            return m_number_of_outputs;
+        }
+
+        //! Retrieve the head size.
+        /** Retrieve the number of samples of the impulse responses convolved in the time domain.
+         @return The head size.
+         */
+        inline ulong getHeadSize() const noexcept
+        {
+            return m_head_size;
+        }
+
+        //! Retrieve the number of stages.
+        /** Retrieve the number of uniform convolvers used after the head.
+         @return The number of stages.
+         */
+        inline ulong getNumberOfStages() const noexcept
+        {
+            return m_stages.size();
+        }
+
+        //! This method allocates the memory of the convolution.
+        /** This method allocates the memory and clears the impulse responses and the state of the convolution. The first samples of the impulse responses are convolved in the time domain when the segment of the head size isn't complete and in the frequency domain otherwise, then each stage convolves two partitions of twice the size of the previous stage. A stage only starts after at least one of its partitions, so its convolution is ready before it is needed.
+         @param size    The maximum size of the impulse responses.
+         @param head    The size of the head and of the partitions of the first stage.
+         */
+        void computeRendering(const ulong size, const ulong head)
+        {
+            clear();
+            m_head_size     = max(head, 1ul);
+            m_response_size = max(size, 1ul);
+            m_ring_size     = m_response_size + m_head_size;
+            m_index         = 0ul;
+            m_count         = 0ul;
+            m_segment       = 0ul;
+            ulong offset    = m_head_size;
+            ulong partition = m_head_size;
+            while(offset < m_response_size)
+            {
+                const ulong length = min(partition * 2ul, m_response_size - offset);
+                Convolver<T>* stage = new Convolver<T>(m_number_of_inputs, m_number_of_outputs);
+                stage->computeRendering(partition, length);
+                m_stages.push_back(stage);
+                m_offsets.push_back(offset);
+                m_fifos.push_back(Signal<T>::alloc(m_number_of_inputs * partition));
+                for(ulong i = 0; i < m_number_of_inputs; i++)
+                {
+                    m_fifo_inputs.push_back(m_fifos.back() + i * partition);
+                }
+                offset    += length;
+                partition *= 2ul;
+            }
+            m_number_of_segments = m_stages.empty() ? 1ul : m_stages.back()->getVectorSize() / m_head_size;
+            m_heads     = Signal<T>::alloc(m_number_of_outputs * m_number_of_inputs * m_head_size);
+            m_starts.assign(m_number_of_outputs * m_number_of_inputs, m_head_size);
+            m_history   = Signal<T>::alloc(m_number_of_inputs * m_head_size * 2ul);
+            m_head      = new Convolver<T>(m_number_of_inputs, m_number_of_outputs);
+            m_head->computeRendering(m_head_size, m_head_size);
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                m_head_inputs.push_back(m_history + i * m_head_size * 2ul + m_head_size);
+            }
+            m_rings     = Signal<T>::alloc(m_number_of_outputs * m_ring_size);
+            m_buffer    = Signal<T>::alloc(m_number_of_outputs * max(partition >> 1, m_head_size));
+            for(ulong i = 0; i < m_number_of_outputs; i++)
+            {
+                m_buffer_outputs.push_back(m_buffer + i * max(partition >> 1, m_head_size));
+            }
+        }
+
+        //! This method sets an impulse response.
+        /** This method stores the head of the impulse response that convolves an input for an output and computes the spectra of the partitions of the stages. The method should be called after computeRendering(). The response is cropped to the maximum size and its trailing zeros are ignored.
+         @param output      The index of the output.
+         @param input       The index of the input.
+         @param size        The size of the impulse response.
+         @param response    The impulse response.
+         @param increment   The increment between two samples of the impulse response.
+         */
+        void setResponse(const ulong output, const ulong input, const ulong size, const T* response, const ulong increment = 1ul)
+        {
+            ulong length = min(size, m_response_size);
+            while(length && response[(length - 1ul) * increment] == T(0.))
+            {
+                length--;
+            }
+            m_starts[output * m_number_of_inputs + input] = m_head_size - min(length, m_head_size);
+            T* head = m_heads + (output * m_number_of_inputs + input) * m_head_size;
+            Signal<T>::clear(m_head_size, head);
+            for(ulong i = 0; i < m_head_size && i < length; i++)
+            {
+                head[m_head_size - 1ul - i] = response[i * increment];
+            }
+            m_head->setResponse(output, input, length, response, increment);
+            for(ulong i = 0; i < m_stages.size(); i++)
+            {
+                const ulong offset = m_offsets[i];
+                m_stages[i]->setResponse(output, input, length > offset ? length - offset : 0ul, response + (length > offset ? offset * increment : 0ul), increment);
+            }
+        }
+
+        //! This method clears the state of the convolution.
+        /** This method clears the past inputs and outputs without changing the impulse responses.
+         */
+        void reset() noexcept
+        {
+            m_index     = 0ul;
+            m_count     = 0ul;
+            m_segment   = 0ul;
+            Signal<T>::clear(m_number_of_inputs * m_head_size * 2ul, m_history);
+            Signal<T>::clear(m_number_of_outputs * m_ring_size, m_rings);
+            m_head->reset();
+            for(ulong i = 0; i < m_stages.size(); i++)
+            {
+                m_stages[i]->reset();
+                Signal<T>::clear(m_number_of_inputs * m_stages[i]->getVectorSize(), m_fifos[i]);
+            }
+        }
+
+        //! This method performs the convolution.
+        /** This method performs the convolution of a vector of each input and sums the results for each output. The number of samples can change from one call to another.
+         @param inputs  The input vectors, the number of vectors must be the number of inputs.
+         @param outputs The output vectors, the number of vectors must be the number of outputs.
+         @param frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            const ulong hsize = m_head_size;
+            ulong pos = 0ul;
+            while(pos < frames)
+            {
+                if(!m_count && frames - pos >= hsize)
+                {
+                    for(ulong i = 0; i < m_number_of_inputs; i++)
+                    {
+                        Signal<T>::copy(hsize, inputs[i] + pos, m_history + i * hsize * 2ul + hsize);
+                    }
+                    m_head->process(m_head_inputs.data(), m_buffer_outputs.data());
+                    const ulong first = min(hsize, m_ring_size - m_index);
+                    for(ulong i = 0; i < m_number_of_outputs; i++)
+                    {
+                        T* ring     = m_rings + i * m_ring_size;
+                        T* output   = outputs[i] + pos;
+                        Signal<T>::add(first, ring + m_index, m_buffer_outputs[i]);
+                        Signal<T>::add(hsize - first, ring, m_buffer_outputs[i] + first);
+                        Signal<T>::clear(first, ring + m_index);
+                        Signal<T>::clear(hsize - first, ring);
+                        Signal<T>::copy(hsize, m_buffer_outputs[i], output);
+                    }
+                    m_index = (m_index + hsize) % m_ring_size;
+                    pos    += hsize;
+                    processSegment(false);
+                    continue;
+                }
+                const ulong size = min(frames - pos, hsize - m_count);
+                for(ulong i = 0; i < m_number_of_inputs; i++)
+                {
+                    Signal<T>::copy(size, inputs[i] + pos, m_history + i * hsize * 2ul + hsize + m_count);
+                }
+                for(ulong i = 0; i < m_number_of_outputs; i++)
+                {
+                    T* ring         = m_rings + i * m_ring_size;
+                    const T* heads  = m_heads + i * m_number_of_inputs * hsize;
+                    const ulong* starts = m_starts.data() + i * m_number_of_inputs;
+                    T* output       = outputs[i] + pos;
+                    ulong index     = m_index;
+                    for(ulong j = 0; j < size; j++)
+                    {
+                        T result = ring[index];
+                        ring[index] = 0;
+                        for(ulong k = 0; k < m_number_of_inputs; k++)
+                        {
+                            const ulong start = starts[k];
+                            result += Signal<T>::dot(hsize - start, m_history + k * hsize * 2ul + m_count + j + 1ul + start, heads + k * hsize + start);
+                        }
+                        output[j] = result;
+                        if(++index == m_ring_size)
+                        {
+                            index = 0ul;
+                        }
+                    }
+                }
+                m_index = (m_index + size) % m_ring_size;
+                m_count += size;
+                pos     += size;
+                if(m_count == hsize)
+                {
+                    m_count = 0ul;
+                    processSegment(true);
+                }
+            }
+        }
+    };
+}
+
+#endif
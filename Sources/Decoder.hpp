@@ -8,7 +8,11 @@
 #define DEF_HOA_DECODER_LIGHT
 
 #include "Encoder.hpp"
+#include "Optim.hpp"
 #include "Hrir.hpp"
+#include "Convolver.hpp"
+#include "Voronoi.hpp"
+#include "Matrices.hpp"
 
 namespace hoa
 {
@@ -37,6 +41,14 @@ namespace hoa
          */
         virtual void process(const T* inputs, T* outputs) noexcept;
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept;
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers and/or calling the process method.
          @param vectorsize The vector size for binaural decoding.
@@ -54,8 +66,9 @@ namespace hoa
             /**	The regular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1 and the number of channels must be at least the number of harmonics.
              @param     order				The order
              @param     numberOfPlanewaves     The number of channels.
+             @param     optim                  The optimization.
              */
-            Regular(const ulong order, const ulong numberOfPlanewaves) noexcept;
+            Regular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<D, T>::Mode optim = Optim<D, T>::BasicMode) noexcept;
 
             //! The destructor.
             /** The destructor free the memory.
@@ -69,6 +82,18 @@ namespace hoa
              */
             virtual void process(const T* inputs, T* outputs) noexcept override;
 
+            //! This method sets the optimization of the decoder.
+            /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+             @param mode The optimization.
+             */
+            void setOptim(const typename Optim<D, T>::Mode mode) noexcept;
+
+            //! This method retrieves the optimization of the decoder.
+            /**	This method retrieves the optimization of the decoder.
+             @return The optimization.
+             */
+            typename Optim<D, T>::Mode getOptim() const noexcept;
+
             //! This method computes the decoding matrix.
             /**	You should use this method after changing the position of the loudspeakers.
              @param vectorsize The vector size for binaural decoding.
@@ -86,8 +111,9 @@ namespace hoa
             /**	The irregular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1.
              @param     order				The order
              @param     numberOfPlanewaves     The number of channels.
+             @param     optim                  The optimization.
              */
-            Irregular(const ulong order, const ulong numberOfPlanewaves) noexcept;
+            Irregular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<D, T>::Mode optim = Optim<D, T>::BasicMode) noexcept;
 
             //! The destructor.
             /** The destructor free the memory.
@@ -101,6 +127,18 @@ namespace hoa
              */
             virtual void process(const T* inputs, T* outputs) noexcept override;
 
+            //! This method sets the optimization of the decoder.
+            /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+             @param mode The optimization.
+             */
+            void setOptim(const typename Optim<D, T>::Mode mode) noexcept;
+
+            //! This method retrieves the optimization of the decoder.
+            /**	This method retrieves the optimization of the decoder.
+             @return The optimization.
+             */
+            typename Optim<D, T>::Mode getOptim() const noexcept;
+
             //! This method computes the decoding matrix.
             /**	You should use this method after changing the position of the loudspeakers.
              @param vectorsize The vector size for binaural decoding.
@@ -116,11 +154,17 @@ namespace hoa
         {
         public:
             //! The binaural decoder constructor.
-            /**	The binaural decoder constructor allocates and initialize the member values to the decoding matrix depending on a order of decomposition and a number of channels. The order and the number of channels must be at least 1.
+            /**	The binaural decoder constructor allocates and initialize the member values to the decoding matrix depending on a order of decomposition and a number of channels. The order and the number of channels must be at least 1. The decoder uses the compiled responses, so it isn't available when HOA_NO_HRIR_TABLES is defined.
              @param     order				The order
              */
             Binaural(const ulong order);
 
+            //! The binaural decoder constructor with a set of responses.
+            /**	The binaural decoder constructor uses the responses of a hrir file instead of the compiled responses, the file must be open and must stay open while the decoder is used.
+             @param     order   The order
+             @param     hrir    The hrir file.
+             */
+            Binaural(const ulong order, const HrirFile<D, T>& hrir);
 
             //! The binaural decoder destructor.
             /**	The binaural decoder destructor free the memory.
@@ -185,6 +229,14 @@ namespace hoa
          */
         inline virtual void process(const T* inputs, T* outputs) noexcept = 0;
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
@@ -216,17 +268,20 @@ namespace hoa
     template <typename T> class Decoder<Hoa2d, T>::Regular : public Decoder<Hoa2d, T>
     {
     private:
-        T*  m_matrix;
+        const T* m_matrix;
+        typename Optim<Hoa2d, T>::Mode m_optim;
     public:
 
         //! The regular constructor.
         /**	The regular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1 and the number of channels must be at least the number of harmonics.
          @param     order				The order
          @param     numberOfPlanewaves     The number of channels.
+         @param     optim                  The optimization.
          */
-        Regular(const ulong order, const ulong numberOfPlanewaves) noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
+        Regular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<Hoa2d, T>::Mode optim = Optim<Hoa2d, T>::BasicMode) noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix = nullptr;
+            m_optim  = optim;
             computeRendering();
         }
 
@@ -235,7 +290,7 @@ namespace hoa
          */
         ~Regular()
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
         }
         
         //! This method retrives the mode of the decoder.
@@ -244,6 +299,18 @@ namespace hoa
          */
         inline Mode getMode() const noexcept {return RegularMode;};
 
+        //! This method sets the optimization of the decoder.
+        /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+         @param mode The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa2d, T>::Mode mode) noexcept {m_optim = mode;};
+
+        //! This method retrieves the optimization of the decoder.
+        /**	This method retrieves the optimization of the decoder.
+         @return The optimization.
+         */
+        inline typename Optim<Hoa2d, T>::Mode getOptim() const noexcept {return m_optim;};
+
         //! This method performs the decoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
          @param     inputs  The input array that contains the samples of the harmonics.
@@ -254,37 +321,76 @@ namespace hoa
             Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), frames, inputs, m_matrix, outputs);
+        }
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
          */
         void computeRendering(const ulong vectorsize = 64) override
         {
+            typename Matrices<T>::Key key("regular", Hoa2d, Decoder<Hoa2d, T>::getDecompositionOrder());
+            key.add(double(m_optim));
+            for(ulong i = 0; i < Decoder<Hoa2d, T>::getNumberOfPlanewaves(); i++)
+            {
+                key.add(Decoder<Hoa2d, T>::getPlanewaveAzimuth(i));
+            }
+            const T* shared = Matrices<T>::acquire(key, Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
             typename Encoder<Hoa2d, T>::Basic encoder(Decoder<Hoa2d, T>::getDecompositionOrder());
             const T factor = 1. / (T)(Decoder<Hoa2d, T>::getDecompositionOrder() + 1.);
             for(ulong i = 0; i < Decoder<Hoa2d, T>::getNumberOfPlanewaves(); i++)
             {
                 encoder.setAzimuth(Decoder<Hoa2d, T>::getPlanewaveAzimuth(i));
-                encoder.process(&factor, m_matrix + i * Decoder<Hoa2d, T>::getNumberOfHarmonics());
-                m_matrix[i * encoder.getNumberOfHarmonics()] = factor * 0.5;
+                encoder.process(&factor, matrix + i * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                matrix[i * encoder.getNumberOfHarmonics()] = factor * 0.5;
+            }
+            for(ulong i = 0; i < Decoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+            {
+                const T weight = Optim<Hoa2d, T>::getWeight(m_optim, Decoder<Hoa2d, T>::getDecompositionOrder(), Decoder<Hoa2d, T>::getHarmonicDegree(i));
+                for(ulong j = 0; j < Decoder<Hoa2d, T>::getNumberOfPlanewaves(); j++)
+                {
+                    matrix[j * Decoder<Hoa2d, T>::getNumberOfHarmonics() + i] *= weight;
+                }
             }
+            shared = Matrices<T>::insert(key, matrix, Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
         }
     };
 
     template <typename T> class Decoder<Hoa2d, T>::Irregular : public Decoder<Hoa2d, T>
     {
     private:
-        T*  m_matrix;
+        const T* m_matrix;
+        typename Optim<Hoa2d, T>::Mode m_optim;
     public:
 
         //! The irregular constructor.
         /**	The irregular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1.
          @param     order				The order
          @param     numberOfPlanewaves     The number of channels.
+         @param     optim                  The optimization.
          */
-        Irregular(const ulong order, const ulong numberOfPlanewaves) noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
+        Irregular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<Hoa2d, T>::Mode optim = Optim<Hoa2d, T>::BasicMode) noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix = nullptr;
+            m_optim  = optim;
             computeRendering();
         }
 
@@ -293,7 +399,7 @@ namespace hoa
          */
         ~Irregular()
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
         }
         
         //! This method retrives the mode of the decoder.
@@ -302,6 +408,18 @@ namespace hoa
          */
         inline Mode getMode() const noexcept {return IrregularMode;};
 
+        //! This method sets the optimization of the decoder.
+        /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+         @param mode The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa2d, T>::Mode mode) noexcept {m_optim = mode;};
+
+        //! This method retrieves the optimization of the decoder.
+        /**	This method retrieves the optimization of the decoder.
+         @return The optimization.
+         */
+        inline typename Optim<Hoa2d, T>::Mode getOptim() const noexcept {return m_optim;};
+
         //! This method performs the decoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
          @param     inputs  The input array that contains the samples of the harmonics.
@@ -312,14 +430,39 @@ namespace hoa
             Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), frames, inputs, m_matrix, outputs);
+        }
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
          */
         void computeRendering(const ulong vectorsize = 64)  override
         {
+            typename Matrices<T>::Key key("irregular", Hoa2d, Decoder<Hoa2d, T>::getDecompositionOrder());
+            key.add(double(m_optim));
+            for(ulong i = 0; i < Decoder<Hoa2d, T>::getNumberOfPlanewaves(); i++)
+            {
+                key.add(Decoder<Hoa2d, T>::getPlanewaveAzimuth(i));
+            }
+            const T* shared = Matrices<T>::acquire(key, Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
             typename Encoder<Hoa2d, T>::Basic encoder(Decoder<Hoa2d, T>::getDecompositionOrder());
-            Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics(), m_matrix);
+            Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics(), matrix);
             T* vector_harmonics = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
             if(Decoder<Hoa2d, T>::getNumberOfPlanewaves() == 1)
@@ -331,7 +474,7 @@ namespace hoa
                     encoder.setAzimuth(T(i) * HOA_2PI / T(nls));
                     encoder.process(&factor, vector_harmonics);
                     vector_harmonics[0] = factor * 0.5;
-                    Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix);
+                    Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix);
                 }
             }
             else
@@ -388,12 +531,12 @@ namespace hoa
                         encoder.setAzimuth(angle);
                         encoder.process(&factor1, vector_harmonics);
                         vector_harmonics[0] = factor1 * 0.5;
-                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[0].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[0].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                         const T factor2 = ((channels[0].getAzimuth(0., 0., 0.) - angle) / portion) * factor;
                         encoder.process(&factor2, vector_harmonics);
                         vector_harmonics[0] = factor2 * 0.5;
-                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[channels.size() - 1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[channels.size() - 1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                         //post("portion : %f", (float)portion / HOA_2PI * 360.f);
                         //post("channel %i (%f) : %f", (int)channels[channels.size()-1].getIndex(),
@@ -411,12 +554,12 @@ namespace hoa
                         encoder.setAzimuth(angle);
                         encoder.process(&factor1, vector_harmonics);
                         vector_harmonics[0] = factor1 * 0.5;
-                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[channels.size()-1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[channels.size()-1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                         const T factor2 = ((angle - channels[channels.size()-1].getAzimuth(0., 0., 0.)) / portion) * factor;
                         encoder.process(&factor2, vector_harmonics);
                         vector_harmonics[0] = factor2 * 0.5;
-                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[0].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                        Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[0].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                         //post("portion : %f", (float)portion / HOA_2PI * 360.f);
                         //post("channel %i (%f) : %f", (int)channels[channels.size()-1].getIndex(),
@@ -438,12 +581,12 @@ namespace hoa
                                 encoder.setAzimuth(angle);
                                 encoder.process(&factor1, vector_harmonics);
                                 vector_harmonics[0] = factor1 * 0.5;
-                                Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[j].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                                Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[j].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                                 const T factor2 = ((channels[j].getAzimuth(0., 0., 0.) - angle) / portion) * factor;
                                 encoder.process(&factor2, vector_harmonics);
                                 vector_harmonics[0] = factor2 * 0.5;
-                                Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, m_matrix + channels[j-1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+                                Signal<T>::add(Decoder<Hoa2d, T>::getNumberOfHarmonics(), vector_harmonics, matrix + channels[j-1].getIndex() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
 
                                 //post("portion : %f", (float)portion / HOA_2PI * 360.f);
                                 //post("channel %i (%f) : %f", (int)channels[j-1].getIndex(),
@@ -462,25 +605,72 @@ namespace hoa
                 channels.clear();
             }
             Signal<T>::free(vector_harmonics);
+            for(ulong i = 0; i < Decoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+            {
+                const T weight = Optim<Hoa2d, T>::getWeight(m_optim, Decoder<Hoa2d, T>::getDecompositionOrder(), Decoder<Hoa2d, T>::getHarmonicDegree(i));
+                for(ulong j = 0; j < Decoder<Hoa2d, T>::getNumberOfPlanewaves(); j++)
+                {
+                    matrix[j * Decoder<Hoa2d, T>::getNumberOfHarmonics() + i] *= weight;
+                }
+            }
+            shared = Matrices<T>::insert(key, matrix, Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
         }
     };
 
     template <typename T> class Decoder<Hoa2d, T>::Binaural : public Decoder<Hoa2d, T>
     {
     private:
-        ulong       m_vector_size;
-        ulong       m_crop_size;
-        T*          m_input;
-        T*          m_result;
-        T*          m_left;
-        T*          m_right;
-        
-        void clear()
+        ulong           m_vector_size;
+        ulong           m_crop_size;
+        const T*        m_left;
+        const T*        m_right;
+        ulong           m_rows;
+        ulong           m_columns;
+        T               m_threshold;
+        ulong           m_response_size;
+        vector<ulong>   m_sizes;
+        Convolver<T>    m_convolver;
+        typename Convolver<T>::NonUniform m_partitioned;
+        T*              m_fifo;
+        ulong           m_count;
+        bool            m_streaming;
+        vector<const T*> m_fifo_inputs;
+        vector<T*>      m_fifo_outputs;
+        vector<const T*> m_sample_inputs;
+
+        //! Computes the size of the response of each harmonic.
+        /** The size of each response is the crop size without the last samples whose energy, summed for both ears, is lower or equal to the threshold relative to the energy of the response.
+         */
+        void computeSizes() noexcept
         {
-            m_input  = Signal<T>::free(m_input);
-            m_result = Signal<T>::free(m_result);
-            m_left   = Signal<T>::free(m_left);
-            m_right  = Signal<T>::free(m_right);
+            m_response_size = 1ul;
+            for(ulong i = 0; i < m_sizes.size(); i++)
+            {
+                T total = 0.;
+                for(ulong j = 0; j < m_crop_size; j++)
+                {
+                    total += m_left[j * m_columns + i] * m_left[j * m_columns + i] + m_right[j * m_columns + i] * m_right[j * m_columns + i];
+                }
+                const T limit = total * m_threshold;
+                ulong size = m_crop_size;
+                T tail = 0.;
+                while(size)
+                {
+                    const T* left  = m_left + (size - 1ul) * m_columns + i;
+                    const T* right = m_right + (size - 1ul) * m_columns + i;
+                    const T energy = left[0] * left[0] + right[0] * right[0];
+                    if(tail + energy > limit)
+                    {
+                        break;
+                    }
+                    tail += energy;
+                    size--;
+                }
+                m_sizes[i]      = size;
+                m_response_size = max(m_response_size, size);
+            }
         }
     public:
 
@@ -490,10 +680,45 @@ namespace hoa
          */
         Binaural(const ulong order) noexcept : Decoder<Hoa2d, T>(order, 2),
         m_vector_size(0ul),
-        m_input(nullptr),
-        m_result(nullptr),
-        m_left(nullptr),
-        m_right(nullptr)
+        m_left(Hrir<Hoa2d, T>::getLeftMatrix()),
+        m_right(Hrir<Hoa2d, T>::getRightMatrix()),
+        m_rows(Hrir<Hoa2d, T>::getNumberOfRows()),
+        m_columns(Hrir<Hoa2d, T>::getNumberOfColumns()),
+        m_threshold(0.),
+        m_response_size(0ul),
+        m_sizes(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 0ul),
+        m_convolver(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_partitioned(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false),
+        m_sample_inputs(m_sizes.size())
+        {
+            Decoder<Hoa2d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
+            Decoder<Hoa2d, T>::setPlanewaveAzimuth(1, (T)(HOA_PI2));
+            setCropSize(0ul);
+        }
+
+        //! The binaural decoder constructor with a set of responses.
+        /**	The binaural decoder constructor uses the responses of a hrir file instead of the compiled responses, the file must be open and must stay open while the decoder is used. The harmonics over the number of columns of the file are ignored.
+         @param     order   The order
+         @param     hrir    The hrir file.
+         */
+        Binaural(const ulong order, const HrirFile<Hoa2d, T>& hrir) noexcept : Decoder<Hoa2d, T>(order, 2),
+        m_vector_size(0ul),
+        m_left(hrir.getLeftMatrix()),
+        m_right(hrir.getRightMatrix()),
+        m_rows(hrir.getNumberOfRows()),
+        m_columns(hrir.getNumberOfColumns()),
+        m_threshold(0.),
+        m_response_size(0ul),
+        m_sizes(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 0ul),
+        m_convolver(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_partitioned(min(m_columns, Harmonic<Hoa2d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false),
+        m_sample_inputs(m_sizes.size())
         {
             Decoder<Hoa2d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
             Decoder<Hoa2d, T>::setPlanewaveAzimuth(1, (T)(HOA_PI2));
@@ -511,19 +736,57 @@ namespace hoa
          */
         ~Binaural() noexcept
         {
-            clear();
+            Signal<T>::free(m_fifo);
         }
         
+        //! This method sets the crop threshold of the responses.
+        /**	This method sets the energy threshold used to crop the response of each harmonic independently after the crop size. The last samples of a response are removed as long as their energy, summed for both ears, is lower or equal to the threshold relative to the energy of the response, for example 0.0001 removes a tail 40 dB under the response. The responses of the harmonics of high degree decay faster, so they are cropped shorter and the convolution skips their removed partitions. A threshold of 0 only removes the trailing zeros.
+         @param threshold The crop threshold.
+         */
+        inline void setCropThreshold(const T threshold) noexcept
+        {
+            m_threshold = max(threshold, T(0.));
+            computeSizes();
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the crop threshold of the responses.
+        /**	This method gets the crop threshold of the responses.
+         @return The crop threshold.
+         */
+        inline T getCropThreshold() const noexcept
+        {
+            return m_threshold;
+        }
+
+        //! This method gets the size of the response of a harmonic.
+        /**	This method gets the size of the response of a harmonic after the crop size and the crop threshold.
+         @param index The index of the harmonic.
+         @return The size of the response.
+         */
+        inline ulong getResponseSize(const ulong index) const noexcept
+        {
+            return index < m_sizes.size() ? m_sizes[index] : 0ul;
+        }
+
         //! This method sets the crop size of the responses.
         /**	This method sets the crop size of the responses.
          @param size The crop size.
          */
         inline void setCropSize(const ulong size) noexcept
         {
-            if(!size || size > Hrir<Hoa2d, T>::getNumberOfRows())
-                m_crop_size = Hrir<Hoa2d, T>::getNumberOfRows();
+            if(!size || size > m_rows)
+                m_crop_size = m_rows;
             else
                 m_crop_size = size;
+            computeSizes();
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
         }
         
         //! This method gets the crop size of the responses.
@@ -532,7 +795,7 @@ namespace hoa
          */
         inline ulong getCropSize() const noexcept
         {
-            if(m_crop_size == Hrir<Hoa2d, T>::getNumberOfRows())
+            if(m_crop_size == m_rows)
             {
                 return 0;
             }
@@ -548,45 +811,155 @@ namespace hoa
          */
         void computeRendering(const ulong vectorsize = 64)  override
         {
-            clear();
             m_vector_size  = vectorsize;
-            m_input  = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfColumns() * m_vector_size);
-            m_result = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() * m_vector_size);
-            m_left   = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
-            m_right  = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
+            m_count        = 0ul;
+            Signal<T>::free(m_fifo);
+            m_fifo = Signal<T>::alloc((m_sizes.size() + 2ul) * m_vector_size);
+            m_fifo_inputs.clear();
+            m_fifo_outputs.clear();
+            for(ulong i = 0; i < m_sizes.size(); i++)
+            {
+                m_fifo_inputs.push_back(m_fifo + i * m_vector_size);
+            }
+            for(ulong i = 0; i < 2ul; i++)
+            {
+                m_fifo_outputs.push_back(m_fifo + (m_sizes.size() + i) * m_vector_size);
+            }
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.computeRendering(m_response_size, max(m_vector_size, 32ul));
+                for(ulong i = 0; i < m_partitioned.getNumberOfInputs(); i++)
+                {
+                    m_partitioned.setResponse(0ul, i, m_sizes[i], m_left + i, m_columns);
+                    m_partitioned.setResponse(1ul, i, m_sizes[i], m_right + i, m_columns);
+                }
+            }
+            else
+            {
+                m_convolver.computeRendering(m_vector_size, m_response_size);
+                for(ulong i = 0; i < m_convolver.getNumberOfInputs(); i++)
+                {
+                    m_convolver.setResponse(0ul, i, m_sizes[i], m_left + i, m_columns);
+                    m_convolver.setResponse(1ul, i, m_sizes[i], m_right + i, m_columns);
+                }
+            }
         }
         
-    private:
-        inline void processChannel(const T* harmonics, const T* response, T* vector, T* output) noexcept
+        //! This method performs the binaural decoding and the convolution.
+        /**	The method convolves the harmonics with the responses of the left and the right ears in the frequency domain. When the vector size is small compared to the crop size, the convolution uses partitions of increasing sizes after a short head convolved in the time domain, otherwise it uses partitions of the vector size. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the left and the right ears. The size of the vectors must be the vector size used to compute the rendering.
+         @param     inputs	The input vectors.
+         @param     outputs  The output vectors.
+         */
+        inline void processBlock(const T** inputs, T** outputs) noexcept
         {
-            const ulong l = Hrir<Hoa2d, T>::getNumberOfColumns();   // Harmonics size aka 11
-            const ulong m = m_crop_size;      // Impulses size
-            const ulong n = m_vector_size;    // Vector size
-            Signal<T>::mul(m, n, l, response, harmonics, m_result);
-            for(ulong i = 0; i < n; i ++)
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.process(inputs, outputs, m_vector_size);
+            }
+            else
             {
-                Signal<T>::add(m, m_result + i, n, vector + i, 1ul);
+                m_convolver.process(inputs, outputs);
             }
-            Signal<T>::copy(m_vector_size, vector, output);
-            Signal<T>::copy(m, vector + m_vector_size, vector);
-            Signal<T>::clear(m_vector_size, vector + m);
         }
-    public:
-        
+
+        //! This method sets the streaming mode.
+        /**	In the streaming mode, when the convolution uses partitions of the vector size, the samples are always buffered until a complete vector and the decoding adds a constant latency of one vector. Otherwise the vectors of the vector size used to compute the rendering don't add any latency, the vectors of other sizes are still buffered but the latency changes with the sizes of the vectors. The mode doesn't change during the processing, so the latency is known before the processing starts. The rendering is computed again if it has already been computed.
+         @param state The streaming mode.
+         */
+        inline void setStreaming(const bool state) noexcept
+        {
+            m_streaming = state;
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the streaming mode.
+        /**	This method gets the streaming mode.
+         @return The streaming mode.
+         */
+        inline bool getStreaming() const noexcept
+        {
+            return m_streaming;
+        }
+
+        //! This method gets the latency of the decoding.
+        /**	This method gets the latency of the decoding. The decoding doesn't add any latency when the convolution uses partitions of increasing sizes or when the streaming mode is disabled and the vectors have the vector size, otherwise the latency is the vector size.
+         @return The latency in samples.
+         */
+        inline ulong getLatency() const noexcept
+        {
+            return (m_streaming && m_response_size <= m_vector_size * 16ul) ? m_vector_size : 0ul;
+        }
+
         //! This method performs the binaural decoding and the convolution.
-        inline void processBlock(const T** inputs, T** outputs) noexcept
+        /**	You should use this method for not-in-place processing and sample by sample. The inputs array contains the samples of the harmonics and the outputs array contains the samples of the left and the right ears. When the convolution uses partitions of the vector size, the samples are buffered until a complete vector, so the sample processing should only be used in the streaming mode for the latency to be the one retrieved with getLatency().
+         @param     inputs  The input samples.
+         @param     outputs The output samples.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
         {
-            T* input = m_input;
-            for(ulong i = 0; i < Hrir<Hoa2d, T>::getNumberOfColumns() && i < Decoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                T* vectors[2] = {outputs, outputs + 1};
+                for(ulong i = 0; i < m_sample_inputs.size(); i++)
+                {
+                    m_sample_inputs[i] = inputs + i;
+                }
+                m_partitioned.process(m_sample_inputs.data(), vectors, 1ul);
+                return;
+            }
+            for(ulong i = 0; i < m_fifo_inputs.size(); i++)
             {
-                Signal<T>::copy(m_vector_size, inputs[i], input);
-                input += m_vector_size;
+                m_fifo[i * m_vector_size + m_count] = inputs[i];
+            }
+            outputs[0] = m_fifo_outputs[0][m_count];
+            outputs[1] = m_fifo_outputs[1][m_count];
+            if(++m_count == m_vector_size)
+            {
+                m_count = 0ul;
+                m_convolver.process(m_fifo_inputs.data(), m_fifo_outputs.data());
             }
-            processChannel(m_input, Hrir<Hoa2d, T>::getLeftMatrix(), m_left, outputs[0]);
-            processChannel(m_input, Hrir<Hoa2d, T>::getRightMatrix(), m_right, outputs[1]);
         }
 
-        inline void process(const T* inputs, T* outputs) noexcept override {}
+        //! This method performs the binaural decoding and the convolution.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the left and the right ears. The number of samples can change from one call to another. When the convolution uses partitions of the vector size and the streaming mode is disabled, the vectors of the vector size used to compute the rendering are convolved directly while the vectors of other sizes are buffered until a complete vector, with a latency of one vector, so the streaming mode should be enabled when the host doesn't always use the vector size.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.process(inputs, outputs, frames);
+                return;
+            }
+            if(!m_streaming && frames == m_vector_size && !m_count)
+            {
+                m_convolver.process(inputs, outputs);
+                return;
+            }
+            ulong pos = 0ul;
+            while(pos < frames)
+            {
+                const ulong size = min(frames - pos, m_vector_size - m_count);
+                for(ulong i = 0; i < m_fifo_inputs.size(); i++)
+                {
+                    Signal<T>::copy(size, inputs[i] + pos, m_fifo + i * m_vector_size + m_count);
+                }
+                Signal<T>::copy(size, m_fifo_outputs[0] + m_count, outputs[0] + pos);
+                Signal<T>::copy(size, m_fifo_outputs[1] + m_count, outputs[1] + pos);
+                m_count += size;
+                pos     += size;
+                if(m_count == m_vector_size)
+                {
+                    m_count = 0ul;
+                    m_convolver.process(m_fifo_inputs.data(), m_fifo_outputs.data());
+                }
+            }
+        }
     };
 
 
@@ -597,6 +970,7 @@ namespace hoa
         enum Mode
         {
             RegularMode = 0,
+            IrregularMode = 1,
             BinauralMode = 2
         };
 
@@ -633,6 +1007,14 @@ namespace hoa
          */
         virtual void process(const T* inputs, T* outputs) noexcept = 0;
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
@@ -644,6 +1026,11 @@ namespace hoa
          */
         class Regular;
 
+        //! The ambisonic irregular decoder.
+        /** The irregular decoder should be used to decode an ambisonic sound field when the loudspeakers are not equally spaced on the sphere, for example for a dome.
+         */
+        class Irregular;
+
         //! The ambisonic binaural decoder.
         /** The binaural decoder should be used to decode an ambisonic sound field for headphones.
          */
@@ -653,17 +1040,20 @@ namespace hoa
     template <typename T> class Decoder<Hoa3d, T>::Regular : public Decoder<Hoa3d, T>
     {
     private:
-        T*  m_matrix;
+        const T* m_matrix;
+        typename Optim<Hoa3d, T>::Mode m_optim;
     public:
 
         //! The regular constructor.
         /**	The regular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1 and the number of channels must be at least the number of harmonics.
          @param     order				The order
          @param     numberOfPlanewaves     The number of channels.
+         @param     optim                  The optimization.
          */
-        Regular(const ulong order, const ulong numberOfPlanewaves) noexcept : Decoder<Hoa3d, T>(order, numberOfPlanewaves)
+        Regular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<Hoa3d, T>::Mode optim = Optim<Hoa3d, T>::BasicMode) noexcept : Decoder<Hoa3d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_matrix = nullptr;
+            m_optim  = optim;
             computeRendering();
         }
         
@@ -673,12 +1063,24 @@ namespace hoa
          */
         inline Mode getMode() const noexcept {return RegularMode;};
 
+        //! This method sets the optimization of the decoder.
+        /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+         @param mode The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa3d, T>::Mode mode) noexcept {m_optim = mode;};
+
+        //! This method retrieves the optimization of the decoder.
+        /**	This method retrieves the optimization of the decoder.
+         @return The optimization.
+         */
+        inline typename Optim<Hoa3d, T>::Mode getOptim() const noexcept {return m_optim;};
+
         //! The regular destructor.
         /**	The regular destructor free the memory.
          */
         ~Regular()
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
         }
 
         //! This method performs the decoding.
@@ -691,50 +1093,347 @@ namespace hoa
             Signal<T>::mul(Decoder<Hoa3d, T>::getNumberOfHarmonics(), Decoder<Hoa3d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
 
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Decoder<Hoa3d, T>::getNumberOfHarmonics(), Decoder<Hoa3d, T>::getNumberOfPlanewaves(), frames, inputs, m_matrix, outputs);
+        }
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
          */
         void computeRendering(const ulong vectorsize = 64)  override
         {
+            typename Matrices<T>::Key key("regular", Hoa3d, Decoder<Hoa3d, T>::getDecompositionOrder());
+            key.add(double(m_optim));
+            for(ulong i = 0; i < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); i++)
+            {
+                key.add(Decoder<Hoa3d, T>::getPlanewaveAzimuth(i));
+                key.add(Decoder<Hoa3d, T>::getPlanewaveElevation(i));
+            }
+            const T* shared = Matrices<T>::acquire(key, Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
             typename Encoder<Hoa3d, T>::Basic encoder(Decoder<Hoa3d, T>::getDecompositionOrder());
             const T factor = 1. / (T)(Decoder<Hoa3d, T>::getNumberOfPlanewaves());
             for(ulong i = 0; i < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); i++)
             {
                 encoder.setAzimuth(Decoder<Hoa3d, T>::getPlanewaveAzimuth(i));
                 encoder.setElevation(Decoder<Hoa3d, T>::getPlanewaveElevation(i));
-                encoder.process(&factor, m_matrix + i * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+                encoder.process(&factor, matrix + i * Decoder<Hoa3d, T>::getNumberOfHarmonics());
                 for(ulong j = 0; j < Decoder<Hoa3d, T>::getNumberOfHarmonics(); j++)
                 {
                     const ulong l = Decoder<Hoa3d, T>::getHarmonicDegree(j);
                     if(encoder.getHarmonicOrder(j) == 0)
                     {
-                        m_matrix[i * encoder.getNumberOfHarmonics() + j] *= (2. * l + 1.);
+                        matrix[i * encoder.getNumberOfHarmonics() + j] *= (2. * l + 1.);
                     }
                     else
                     {
-                        m_matrix[i * encoder.getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
+                        matrix[i * encoder.getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
                     }
                 }
             }
+            for(ulong i = 0; i < Decoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
+            {
+                const T weight = Optim<Hoa3d, T>::getWeight(m_optim, Decoder<Hoa3d, T>::getDecompositionOrder(), Decoder<Hoa3d, T>::getHarmonicDegree(i));
+                for(ulong j = 0; j < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); j++)
+                {
+                    matrix[j * Decoder<Hoa3d, T>::getNumberOfHarmonics() + i] *= weight;
+                }
+            }
+            shared = Matrices<T>::insert(key, matrix, Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
         }
     };
     
+    template <typename T> class Decoder<Hoa3d, T>::Irregular : public Decoder<Hoa3d, T>
+    {
+    private:
+        const T* m_matrix;
+        typename Optim<Hoa3d, T>::Mode m_optim;
+
+        //! Computes the vector based amplitude panning gains of a direction in a triangle.
+        /** The gains are the coordinates of the direction in the base of the three loudspeakers of the triangle.
+         @param     base        The positions of the three loudspeakers, one per row.
+         @param     direction   The direction.
+         @param     gains       The gains.
+         @return    True if the direction is inside the triangle.
+         */
+        static bool pan(const double* base, const double* direction, double* gains) noexcept
+        {
+            const double det = base[0] * (base[4] * base[8] - base[5] * base[7]) - base[1] * (base[3] * base[8] - base[5] * base[6]) + base[2] * (base[3] * base[7] - base[4] * base[6]);
+            if(fabs(det) < HOA_EPSILON)
+            {
+                return false;
+            }
+            for(ulong i = 0; i < 3; i++)
+            {
+                const double* b = base + ((i + 1) % 3) * 3;
+                const double* c = base + ((i + 2) % 3) * 3;
+                gains[i] = (direction[0] * (b[1] * c[2] - b[2] * c[1]) + direction[1] * (b[2] * c[0] - b[0] * c[2]) + direction[2] * (b[0] * c[1] - b[1] * c[0])) / det;
+            }
+            return gains[0] > -HOA_EPSILON && gains[1] > -HOA_EPSILON && gains[2] > -HOA_EPSILON;
+        }
+
+    public:
+
+        //! The irregular constructor.
+        /**	The irregular constructor allocates and initialize the decoding matrix depending on a order of decomposition and a number of channels. The order must be at least 1.
+         @param     order				The order
+         @param     numberOfPlanewaves     The number of channels.
+         @param     optim                  The optimization.
+         */
+        Irregular(const ulong order, const ulong numberOfPlanewaves, const typename Optim<Hoa3d, T>::Mode optim = Optim<Hoa3d, T>::BasicMode) noexcept : Decoder<Hoa3d, T>(order, numberOfPlanewaves)
+        {
+            m_matrix = nullptr;
+            m_optim  = optim;
+            computeRendering();
+        }
+
+        //! This method retrives the mode of the decoder.
+        /**	This method retrives the mode of the decoder.
+         @retun The mode of the decoder.
+         */
+        inline Mode getMode() const noexcept {return IrregularMode;};
+
+        //! This method sets the optimization of the decoder.
+        /**	The optimization is folded into the decoding matrix, so the harmonics don't need to be optimized before the decoding. You should compute the rendering after changing the optimization.
+         @param mode The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa3d, T>::Mode mode) noexcept {m_optim = mode;};
+
+        //! This method retrieves the optimization of the decoder.
+        /**	This method retrieves the optimization of the decoder.
+         @return The optimization.
+         */
+        inline typename Optim<Hoa3d, T>::Mode getOptim() const noexcept {return m_optim;};
+
+        //! The irregular destructor.
+        /**	The irregular destructor free the memory.
+         */
+        ~Irregular()
+        {
+            Matrices<T>::release(m_matrix);
+        }
+
+        //! This method performs the decoding.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
+         @param     inputs  The input array that contains the samples of the harmonics.
+         @param     outputs The output array that contains samples destinated to channels.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
+        {
+            Signal<T>::mul(Decoder<Hoa3d, T>::getNumberOfHarmonics(), Decoder<Hoa3d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+        }
+
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors destinated to the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Decoder<Hoa3d, T>::getNumberOfHarmonics(), Decoder<Hoa3d, T>::getNumberOfPlanewaves(), frames, inputs, m_matrix, outputs);
+        }
+
+        //! This method computes the decoding matrix.
+        /**	You should use this method after changing the position of the loudspeakers. The sound field is decoded for a dense and nearly uniform set of virtual loudspeakers then each virtual loudspeaker is panned on the real loudspeakers with the vector based amplitude panning over the delaunay triangulation of the loudspeakers. Imaginary loudspeakers are added at the bottom and at the top of the sphere when there is no loudspeaker under or over the horizontal plane and their signals are discarded. The virtual loudspeakers are placed on a spherical fibonacci lattice and both steps are merged into a single matrix, so the decoding costs the same as the regular decoding. The triangulation tests every triangle of loudspeakers against every loudspeaker, so its cost grows with the fourth power of the number of loudspeakers and the decoder is meant for layouts of up to about a hundred loudspeakers, the matrix is shared between the decoders with the same layout so it is only computed when the layout changes.
+         @param vectorsize The vector size for binaural decoding.
+         */
+        void computeRendering(const ulong vectorsize = 64)  override
+        {
+            typename Matrices<T>::Key key("irregular", Hoa3d, Decoder<Hoa3d, T>::getDecompositionOrder());
+            key.add(double(m_optim));
+            for(ulong i = 0; i < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); i++)
+            {
+                key.add(Decoder<Hoa3d, T>::getPlanewaveAzimuth(i));
+                key.add(Decoder<Hoa3d, T>::getPlanewaveElevation(i));
+            }
+            const T* shared = Matrices<T>::acquire(key, Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            const ulong nplws   = Decoder<Hoa3d, T>::getNumberOfPlanewaves();
+            const ulong nharm   = Decoder<Hoa3d, T>::getNumberOfHarmonics();
+            const ulong order   = Decoder<Hoa3d, T>::getDecompositionOrder();
+            const ulong nvirtual= max(240ul, 8ul * (order + 1ul) * (order + 1ul));
+            Signal<T>::clear(nplws * nharm, matrix);
+
+            Voronoi<Hoa3d> voronoi;
+            bool top = false;
+            for(ulong i = 0; i < nplws; i++)
+            {
+                const double z = Decoder<Hoa3d, T>::getPlanewaveHeight(i);
+                voronoi.add(Voronoi<Hoa3d>::Point(Decoder<Hoa3d, T>::getPlanewaveAbscissa(i), Decoder<Hoa3d, T>::getPlanewaveOrdinate(i), z));
+                top = top || z > 0.;
+            }
+            if(!top)
+            {
+                voronoi.add(Voronoi<Hoa3d>::Point(0., 0., 1.));
+            }
+            voronoi.compute();
+
+            const vector<Voronoi<Hoa3d>::Point>& points = voronoi.getPoints();
+            const vector<ulong>& triangles = voronoi.getTriangles();
+            vector<double> bases(triangles.size() * 3);
+            for(ulong i = 0; i < triangles.size(); i++)
+            {
+                bases[i * 3]        = points[triangles[i]].x;
+                bases[i * 3 + 1]    = points[triangles[i]].y;
+                bases[i * 3 + 2]    = points[triangles[i]].z;
+            }
+
+            typename Encoder<Hoa3d, T>::Basic encoder(order);
+            T* vector_harmonics = Signal<T>::alloc(nharm);
+            const T factor      = 1. / (T)(nvirtual);
+            ulong triangle      = 0ul;
+            for(ulong i = 0; i < nvirtual; i++)
+            {
+                const double z          = 1. - (2. * double(i) + 1.) / double(nvirtual);
+                const double radius     = sqrt(1. - z * z);
+                const double angle      = double(i) * HOA_PI * (3. - sqrt(5.));
+                const double direction[3] = {radius * cos(angle), radius * sin(angle), z};
+
+                double gains[3] = {0., 0., 0.};
+                bool found = false;
+                for(ulong j = 0; j < triangles.size() / 3 && !found; j++)
+                {
+                    const ulong index = (triangle + j) % (triangles.size() / 3);
+                    if(pan(bases.data() + index * 9, direction, gains))
+                    {
+                        triangle = index;
+                        found    = true;
+                    }
+                }
+
+                encoder.setAzimuth(Math<T>::azimuth(direction[0], direction[1], direction[2]));
+                encoder.setElevation(Math<T>::elevation(direction[0], direction[1], direction[2]));
+                encoder.process(&factor, vector_harmonics);
+                for(ulong j = 0; j < nharm; j++)
+                {
+                    const ulong l = Decoder<Hoa3d, T>::getHarmonicDegree(j);
+                    if(encoder.getHarmonicOrder(j) == 0)
+                    {
+                        vector_harmonics[j] *= (2. * l + 1.);
+                    }
+                    else
+                    {
+                        vector_harmonics[j] *= T(2. * l + 1.) * 4. * HOA_PI;
+                    }
+                }
+
+                if(found)
+                {
+                    const double norm = sqrt(gains[0] * gains[0] + gains[1] * gains[1] + gains[2] * gains[2]);
+                    for(ulong j = 0; j < 3; j++)
+                    {
+                        const ulong index = triangles[triangle * 3 + j];
+                        if(index < nplws && norm > 0.)
+                        {
+                            Signal<T>::add(nharm, T(gains[j] / norm), vector_harmonics, matrix + index * nharm);
+                        }
+                    }
+                }
+                else
+                {
+                    ulong closest = 0ul;
+                    double distance = -2.;
+                    for(ulong j = 0; j < nplws; j++)
+                    {
+                        const double d = (points[j].x * direction[0] + points[j].y * direction[1] + points[j].z * direction[2]);
+                        if(d > distance)
+                        {
+                            distance = d;
+                            closest  = j;
+                        }
+                    }
+                    Signal<T>::add(nharm, vector_harmonics, matrix + closest * nharm);
+                }
+            }
+            Signal<T>::free(vector_harmonics);
+            for(ulong i = 0; i < Decoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
+            {
+                const T weight = Optim<Hoa3d, T>::getWeight(m_optim, Decoder<Hoa3d, T>::getDecompositionOrder(), Decoder<Hoa3d, T>::getHarmonicDegree(i));
+                for(ulong j = 0; j < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); j++)
+                {
+                    matrix[j * Decoder<Hoa3d, T>::getNumberOfHarmonics() + i] *= weight;
+                }
+            }
+            shared = Matrices<T>::insert(key, matrix, Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
+        }
+    };
+
     template <typename T> class Decoder<Hoa3d, T>::Binaural : public Decoder<Hoa3d, T>
     {
-        ulong       m_vector_size;
-        ulong       m_crop_size;
-        T*          m_input;
-        T*          m_result;
-        T*          m_left;
-        T*          m_right;
-        
-        void clear()
+        ulong           m_vector_size;
+        ulong           m_crop_size;
+        const T*        m_left;
+        const T*        m_right;
+        ulong           m_rows;
+        ulong           m_columns;
+        T               m_threshold;
+        ulong           m_response_size;
+        vector<ulong>   m_sizes;
+        Convolver<T>    m_convolver;
+        typename Convolver<T>::NonUniform m_partitioned;
+        T*              m_fifo;
+        ulong           m_count;
+        bool            m_streaming;
+        vector<const T*> m_fifo_inputs;
+        vector<T*>      m_fifo_outputs;
+        vector<const T*> m_sample_inputs;
+
+        //! Computes the size of the response of each harmonic.
+        /** The size of each response is the crop size without the last samples whose energy, summed for both ears, is lower or equal to the threshold relative to the energy of the response.
+         */
+        void computeSizes() noexcept
         {
-            m_input  = Signal<T>::free(m_input);
-            m_result = Signal<T>::free(m_result);
-            m_left   = Signal<T>::free(m_left);
-            m_right  = Signal<T>::free(m_right);
+            m_response_size = 1ul;
+            for(ulong i = 0; i < m_sizes.size(); i++)
+            {
+                T total = 0.;
+                for(ulong j = 0; j < m_crop_size; j++)
+                {
+                    total += m_left[j * m_columns + i] * m_left[j * m_columns + i] + m_right[j * m_columns + i] * m_right[j * m_columns + i];
+                }
+                const T limit = total * m_threshold;
+                ulong size = m_crop_size;
+                T tail = 0.;
+                while(size)
+                {
+                    const T* left  = m_left + (size - 1ul) * m_columns + i;
+                    const T* right = m_right + (size - 1ul) * m_columns + i;
+                    const T energy = left[0] * left[0] + right[0] * right[0];
+                    if(tail + energy > limit)
+                    {
+                        break;
+                    }
+                    tail += energy;
+                    size--;
+                }
+                m_sizes[i]      = size;
+                m_response_size = max(m_response_size, size);
+            }
         }
         
     public:
@@ -745,10 +1444,45 @@ namespace hoa
          */
         Binaural(const ulong order) : Decoder<Hoa3d, T>(order, 2),
         m_vector_size(0ul),
-        m_input(nullptr),
-        m_result(nullptr),
-        m_left(nullptr),
-        m_right(nullptr)
+        m_left(Hrir<Hoa3d, T>::getLeftMatrix()),
+        m_right(Hrir<Hoa3d, T>::getRightMatrix()),
+        m_rows(Hrir<Hoa3d, T>::getNumberOfRows()),
+        m_columns(Hrir<Hoa3d, T>::getNumberOfColumns()),
+        m_threshold(0.),
+        m_response_size(0ul),
+        m_sizes(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 0ul),
+        m_convolver(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_partitioned(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false),
+        m_sample_inputs(m_sizes.size())
+        {
+            Decoder<Hoa3d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
+            Decoder<Hoa3d, T>::setPlanewaveAzimuth(1, (T)HOA_PI2);
+            setCropSize(0ul);
+        }
+
+        //! The binaural decoder constructor with a set of responses.
+        /**	The binaural decoder constructor uses the responses of a hrir file instead of the compiled responses, the file must be open and must stay open while the decoder is used. The harmonics over the number of columns of the file are ignored.
+         @param     order   The order
+         @param     hrir    The hrir file.
+         */
+        Binaural(const ulong order, const HrirFile<Hoa3d, T>& hrir) : Decoder<Hoa3d, T>(order, 2),
+        m_vector_size(0ul),
+        m_left(hrir.getLeftMatrix()),
+        m_right(hrir.getRightMatrix()),
+        m_rows(hrir.getNumberOfRows()),
+        m_columns(hrir.getNumberOfColumns()),
+        m_threshold(0.),
+        m_response_size(0ul),
+        m_sizes(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 0ul),
+        m_convolver(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_partitioned(min(m_columns, Harmonic<Hoa3d, T>::getNumberOfHarmonics(order)), 2ul),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false),
+        m_sample_inputs(m_sizes.size())
         {
             Decoder<Hoa3d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
             Decoder<Hoa3d, T>::setPlanewaveAzimuth(1, (T)HOA_PI2);
@@ -766,7 +1500,40 @@ namespace hoa
          */
         ~Binaural()
         {
-            clear();
+            Signal<T>::free(m_fifo);
+        }
+
+        //! This method sets the crop threshold of the responses.
+        /**	This method sets the energy threshold used to crop the response of each harmonic independently after the crop size. The last samples of a response are removed as long as their energy, summed for both ears, is lower or equal to the threshold relative to the energy of the response, for example 0.0001 removes a tail 40 dB under the response. The responses of the harmonics of high degree decay faster, so they are cropped shorter and the convolution skips their removed partitions. A threshold of 0 only removes the trailing zeros.
+         @param threshold The crop threshold.
+         */
+        inline void setCropThreshold(const T threshold) noexcept
+        {
+            m_threshold = max(threshold, T(0.));
+            computeSizes();
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the crop threshold of the responses.
+        /**	This method gets the crop threshold of the responses.
+         @return The crop threshold.
+         */
+        inline T getCropThreshold() const noexcept
+        {
+            return m_threshold;
+        }
+
+        //! This method gets the size of the response of a harmonic.
+        /**	This method gets the size of the response of a harmonic after the crop size and the crop threshold.
+         @param index The index of the harmonic.
+         @return The size of the response.
+         */
+        inline ulong getResponseSize(const ulong index) const noexcept
+        {
+            return index < m_sizes.size() ? m_sizes[index] : 0ul;
         }
 
         //! This method sets the crop size of the responses.
@@ -775,14 +1542,19 @@ namespace hoa
          */
         inline void setCropSize(const ulong size) noexcept
         {
-            if(!size || size > Hrir<Hoa3d, T>::getNumberOfRows())
+            if(!size || size > m_rows)
             {
-                m_crop_size = Hrir<Hoa3d, T>::getNumberOfRows();
+                m_crop_size = m_rows;
             }
             else
             {
                 m_crop_size = size;
             }
+            computeSizes();
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
         }
         
         //! This method gets the crop size of the responses.
@@ -791,7 +1563,7 @@ namespace hoa
          */
         inline ulong getCropSize() const noexcept
         {
-            if(m_crop_size == Hrir<Hoa3d, T>::getNumberOfRows())
+            if(m_crop_size == m_rows)
             {
                 return 0;
             }
@@ -807,46 +1579,155 @@ namespace hoa
          */
         void computeRendering(const ulong vectorsize = 64) override
         {
-            clear();
             m_vector_size  = vectorsize;
-            m_input  = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfColumns() * m_vector_size);
-            m_result = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() * m_vector_size);
-            m_left   = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
-            m_right  = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
+            m_count        = 0ul;
+            Signal<T>::free(m_fifo);
+            m_fifo = Signal<T>::alloc((m_sizes.size() + 2ul) * m_vector_size);
+            m_fifo_inputs.clear();
+            m_fifo_outputs.clear();
+            for(ulong i = 0; i < m_sizes.size(); i++)
+            {
+                m_fifo_inputs.push_back(m_fifo + i * m_vector_size);
+            }
+            for(ulong i = 0; i < 2ul; i++)
+            {
+                m_fifo_outputs.push_back(m_fifo + (m_sizes.size() + i) * m_vector_size);
+            }
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.computeRendering(m_response_size, max(m_vector_size, 32ul));
+                for(ulong i = 0; i < m_partitioned.getNumberOfInputs(); i++)
+                {
+                    m_partitioned.setResponse(0ul, i, m_sizes[i], m_left + i, m_columns);
+                    m_partitioned.setResponse(1ul, i, m_sizes[i], m_right + i, m_columns);
+                }
+            }
+            else
+            {
+                m_convolver.computeRendering(m_vector_size, m_response_size);
+                for(ulong i = 0; i < m_convolver.getNumberOfInputs(); i++)
+                {
+                    m_convolver.setResponse(0ul, i, m_sizes[i], m_left + i, m_columns);
+                    m_convolver.setResponse(1ul, i, m_sizes[i], m_right + i, m_columns);
+                }
+            }
         }
         
-    private:
-        inline void processChannel(const T* harmonics, const T* response, T* vector, T* output) noexcept
+        //! This method performs the binaural decoding and the convolution.
+        /**	The method convolves the harmonics with the responses of the left and the right ears in the frequency domain. When the vector size is small compared to the crop size, the convolution uses partitions of increasing sizes after a short head convolved in the time domain, otherwise it uses partitions of the vector size. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the left and the right ears. The size of the vectors must be the vector size used to compute the rendering.
+         @param     inputs	The input vectors.
+         @param     outputs  The output vectors.
+         */
+        inline void processBlock(const T** inputs, T** outputs) noexcept
         {
-            const ulong l = Hrir<Hoa3d, T>::getNumberOfColumns();   // Harmonics size aka 11
-            const ulong m = m_crop_size;      // Impulses size
-            const ulong n = m_vector_size;    // Vector size
-            Signal<T>::mul(m, n, l, response, harmonics, m_result);
-            for(ulong i = 0; i < n; i ++)
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.process(inputs, outputs, m_vector_size);
+            }
+            else
             {
-                Signal<T>::add(m, m_result + i, n, vector + i, 1ul);
+                m_convolver.process(inputs, outputs);
             }
-            
-            Signal<T>::copy(m_vector_size, vector, output);
-            Signal<T>::copy(m, vector + m_vector_size, vector);
-            Signal<T>::clear(m_vector_size, vector + m);
         }
-    public:
-        
+
+        //! This method sets the streaming mode.
+        /**	In the streaming mode, when the convolution uses partitions of the vector size, the samples are always buffered until a complete vector and the decoding adds a constant latency of one vector. Otherwise the vectors of the vector size used to compute the rendering don't add any latency, the vectors of other sizes are still buffered but the latency changes with the sizes of the vectors. The mode doesn't change during the processing, so the latency is known before the processing starts. The rendering is computed again if it has already been computed.
+         @param state The streaming mode.
+         */
+        inline void setStreaming(const bool state) noexcept
+        {
+            m_streaming = state;
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the streaming mode.
+        /**	This method gets the streaming mode.
+         @return The streaming mode.
+         */
+        inline bool getStreaming() const noexcept
+        {
+            return m_streaming;
+        }
+
+        //! This method gets the latency of the decoding.
+        /**	This method gets the latency of the decoding. The decoding doesn't add any latency when the convolution uses partitions of increasing sizes or when the streaming mode is disabled and the vectors have the vector size, otherwise the latency is the vector size.
+         @return The latency in samples.
+         */
+        inline ulong getLatency() const noexcept
+        {
+            return (m_streaming && m_response_size <= m_vector_size * 16ul) ? m_vector_size : 0ul;
+        }
+
         //! This method performs the binaural decoding and the convolution.
-        inline void processBlock(const T** inputs, T** outputs) noexcept
+        /**	You should use this method for not-in-place processing and sample by sample. The inputs array contains the samples of the harmonics and the outputs array contains the samples of the left and the right ears. When the convolution uses partitions of the vector size, the samples are buffered until a complete vector, so the sample processing should only be used in the streaming mode for the latency to be the one retrieved with getLatency().
+         @param     inputs  The input samples.
+         @param     outputs The output samples.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
         {
-            T* input = m_input;
-            for(ulong i = 0; i < Hrir<Hoa3d, T>::getNumberOfColumns() && i < Decoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                T* vectors[2] = {outputs, outputs + 1};
+                for(ulong i = 0; i < m_sample_inputs.size(); i++)
+                {
+                    m_sample_inputs[i] = inputs + i;
+                }
+                m_partitioned.process(m_sample_inputs.data(), vectors, 1ul);
+                return;
+            }
+            for(ulong i = 0; i < m_fifo_inputs.size(); i++)
+            {
+                m_fifo[i * m_vector_size + m_count] = inputs[i];
+            }
+            outputs[0] = m_fifo_outputs[0][m_count];
+            outputs[1] = m_fifo_outputs[1][m_count];
+            if(++m_count == m_vector_size)
             {
-                Signal<T>::copy(m_vector_size, inputs[i], input);
-                input += m_vector_size;
+                m_count = 0ul;
+                m_convolver.process(m_fifo_inputs.data(), m_fifo_outputs.data());
+            }
+        }
+
+        //! This method performs the binaural decoding and the convolution.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the left and the right ears. The number of samples can change from one call to another. When the convolution uses partitions of the vector size and the streaming mode is disabled, the vectors of the vector size used to compute the rendering are convolved directly while the vectors of other sizes are buffered until a complete vector, with a latency of one vector, so the streaming mode should be enabled when the host doesn't always use the vector size.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(m_response_size > m_vector_size * 16ul)
+            {
+                m_partitioned.process(inputs, outputs, frames);
+                return;
+            }
+            if(!m_streaming && frames == m_vector_size && !m_count)
+            {
+                m_convolver.process(inputs, outputs);
+                return;
+            }
+            ulong pos = 0ul;
+            while(pos < frames)
+            {
+                const ulong size = min(frames - pos, m_vector_size - m_count);
+                for(ulong i = 0; i < m_fifo_inputs.size(); i++)
+                {
+                    Signal<T>::copy(size, inputs[i] + pos, m_fifo + i * m_vector_size + m_count);
+                }
+                Signal<T>::copy(size, m_fifo_outputs[0] + m_count, outputs[0] + pos);
+                Signal<T>::copy(size, m_fifo_outputs[1] + m_count, outputs[1] + pos);
+                m_count += size;
+                pos     += size;
+                if(m_count == m_vector_size)
+                {
+                    m_count = 0ul;
+                    m_convolver.process(m_fifo_inputs.data(), m_fifo_outputs.data());
+                }
             }
-            processChannel(m_input, Hrir<Hoa3d, T>::getLeftMatrix(), m_left, outputs[0]);
-            processChannel(m_input, Hrir<Hoa3d, T>::getRightMatrix(), m_right, outputs[1]);
         }
-        
-        inline void process(const T* inputs, T* outputs) noexcept override {}
 
     };
 
@@ -15,6 +15,7 @@
 
 #include <string>
 #include <cmath>
+#include <cstring>
 #include <vector>
 #include <map>
 #include <algorithm>
@@ -8,6 +8,8 @@
 #define DEF_HOA_ENCODER_LIGHT
 
 #include "Processor.hpp"
+#include "Optim.hpp"
+#include "Pool.hpp"
 
 namespace hoa
 {
@@ -36,6 +38,14 @@ namespace hoa
          */
         virtual void process(const T* input, T* outputs) noexcept;
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept;
+
         //! The basic encoder class generates the harmonics for one signal according to an azimuth and an elevation.
         /** The basic encoder should be used to encode a signal in the harmonics domain depending on an order of decomposition. It allows to control the azimuth and the elevation of the signal.
          */
@@ -122,6 +132,18 @@ namespace hoa
              @param     outputs  The outputs array.
              */
             virtual void processAdd(const T* input, T* outputs) noexcept;
+
+            //! The fixed basic encoder class generates the harmonics for one signal with an order of decomposition known at compile time.
+            /** The fixed basic encoder performs the same encoding as the basic encoder but the recurrences are unrolled at compile time and the normalizations are constant expressions.
+             */
+            template <ulong N> class Fixed;
+
+            //! This method creates a basic encoder.
+            /**	This method creates a fixed basic encoder for the orders 1 to 7 and a basic encoder for the higher orders. The encoder must be deleted by the caller.
+             @param     order	The order.
+             @return    The basic encoder.
+             */
+            static Basic* create(const ulong order);
         };
 
         //! The dc encoder class generates the harmonics for one signal according to an azimuth, an elevation and a radius.
@@ -223,8 +245,9 @@ namespace hoa
 
              @param     order            The order.
              @param     numberOfSources	The number of sources.
+             @param     optim           The optimization.
              */
-            Multi(const ulong order, ulong numberOfSources) noexcept;
+            Multi(const ulong order, ulong numberOfSources, const typename Optim<D, T>::Mode optim = Optim<D, T>::BasicMode) noexcept;
 
             //! The multi encoder destructor.
             /**	The multi encoder destructor free the memory and deallocate the member classes.
@@ -237,6 +260,18 @@ namespace hoa
              */
             virtual ulong getNumberOfSources() const noexcept;
 
+            //! This method sets the optimization of the sources.
+            /**	The weights of the optimization are folded into the harmonics coefficients of the sources, so the harmonics don't need to be optimized after the encoding.
+             @param     mode    The optimization.
+             */
+            virtual void setOptim(const typename Optim<D, T>::Mode mode) noexcept;
+
+            //! This method retrieves the optimization of the sources.
+            /**	Retrieve the optimization of the sources.
+             @return    The optimization.
+             */
+            virtual typename Optim<D, T>::Mode getOptim() const noexcept;
+
             //! Set the azimuth of a signal.
             /**	This method  sets the azimuth \f$\theta_{index}\f$ of a signal in radian and you should prefer to use it between \f$0\f$ and \f$2\pi\f$ to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The \f$0\f$ radian is \f$\frac{\pi}{2}\f$ phase shifted relative to a mathematical representation of a circle, then the \f$0\f$ radian is at the "front" of the soundfield.
              @param index   The index of the signal.
@@ -308,6 +343,10 @@ namespace hoa
 
     template <typename T> class Encoder<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
     {
+    private:
+        T*      m_harmonics;
+        T*      m_previous;
+        bool    m_started;
     public:
 
         //! The encoder constructor.
@@ -316,7 +355,9 @@ namespace hoa
          */
         Encoder(const ulong order) noexcept : Processor<Hoa2d, T>::Harmonics(order)
         {
-            ;
+            m_harmonics = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_previous  = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_started   = false;
         }
 
         //! The encoder destructor.
@@ -324,7 +365,8 @@ namespace hoa
          */
         virtual ~Encoder() noexcept
         {
-
+            Signal<T>::free(m_harmonics);
+            Signal<T>::free(m_previous);
         }
 
         //! This method performs the encoding.
@@ -334,6 +376,37 @@ namespace hoa
          */
         virtual void process(const T* input, T* outputs) noexcept = 0;
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The harmonics coefficients are computed once per vector and, if they changed since the previous vector, they are linearly interpolated over the vector so the source can be moved once per vector without zipper noise. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T factor = 1.;
+            const ulong size = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            process(&factor, m_harmonics);
+            if(m_started && memcmp(m_harmonics, m_previous, size * sizeof(T)))
+            {
+                const T step = T(1.) / T(frames);
+                for(ulong i = size; i; i--)
+                {
+                    const T delta = (m_harmonics[i-1] - m_previous[i-1]) * step;
+                    Signal<T>::ramp(frames, m_previous[i-1] + delta, delta, inputs[0], outputs[i-1]);
+                }
+            }
+            else
+            {
+                for(ulong i = size; i; i--)
+                {
+                    Signal<T>::scale(frames, m_harmonics[i-1], inputs[0], outputs[i-1]);
+                }
+            }
+            Signal<T>::copy(size, m_harmonics, m_previous);
+            m_started = true;
+        }
+
         //! The basic encoder class generates the harmonics for one signal according to an azimuth and an elevation.
         /** The basic encoder should be used to encode a signal in the harmonics domain depending on an order of decomposition. It allows to control the azimuth and the elevation of the signal.
          */
@@ -450,6 +523,17 @@ namespace hoa
             }
         }
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa2d, T>::process(inputs, outputs, frames);
+        }
+
         //! This method performs the encoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
@@ -457,7 +541,7 @@ namespace hoa
          @param     input	The input sample.
          @param     outputs The output array.
          */
-        inline void processAdd(const T* input, T* outputs) noexcept
+        virtual void processAdd(const T* input, T* outputs) noexcept
         {
             if(!m_muted)
             {
@@ -478,6 +562,121 @@ namespace hoa
                 }
             }
         }
+
+        //! The fixed basic encoder class generates the harmonics for one signal with an order of decomposition known at compile time.
+        /** The fixed basic encoder performs the same encoding as the basic encoder but the recurrences are unrolled at compile time.
+         */
+        template <ulong N> class Fixed;
+
+        //! This method creates a basic encoder.
+        /**	This method creates a fixed basic encoder for the orders 1 to 7 and a basic encoder for the higher orders. The encoder must be deleted by the caller.
+         @param     order	The order.
+         @return    The basic encoder.
+         */
+        static Basic* create(const ulong order)
+        {
+            switch(order)
+            {
+                case 1: return new Fixed<1>();
+                case 2: return new Fixed<2>();
+                case 3: return new Fixed<3>();
+                case 4: return new Fixed<4>();
+                case 5: return new Fixed<5>();
+                case 6: return new Fixed<6>();
+                case 7: return new Fixed<7>();
+                default: return new Basic(order);
+            }
+        }
+    };
+
+    template <typename T> template <ulong N> class Encoder<Hoa2d, T>::Basic::Fixed : public Encoder<Hoa2d, T>::Basic
+    {
+    private:
+
+        //! The unrolled recurrence of the circular harmonics of degree L and above.
+        template <ulong L, bool Add, bool End = (L > N)> struct Degree
+        {
+            static inline void process(const T input, const T cosx, const T sinx, const T cos_l, const T sin_l, T* outputs) noexcept
+            {
+                if(Add)
+                {
+                    outputs[2 * L - 1] += input * sin_l;    // Hamonic [L,-L]
+                    outputs[2 * L]     += input * cos_l;    // Hamonic [L,L]
+                }
+                else
+                {
+                    outputs[2 * L - 1] = input * sin_l;     // Hamonic [L,-L]
+                    outputs[2 * L]     = input * cos_l;     // Hamonic [L,L]
+                }
+                Degree<L + 1, Add>::process(input, cosx, sinx, cos_l * cosx - sin_l * sinx, cos_l * sinx + sin_l * cosx, outputs);
+            }
+        };
+
+        template <ulong L, bool Add> struct Degree<L, Add, true>
+        {
+            static inline void process(const T, const T, const T, const T, const T, T*) noexcept {}
+        };
+
+    public:
+
+        //! The fixed encoder constructor.
+        /**	The fixed encoder constructor allocates and initialize the member values to computes circular harmonics coefficients for the encoding.
+         */
+        Fixed() noexcept : Encoder<Hoa2d, T>::Basic(N)
+        {
+            static_assert(N > 0, "The order must be at least 1.");
+        }
+
+        //! The fixed encoder destructor.
+        /**	The fixed encoder destructor free the memory.
+         */
+        ~Fixed() noexcept
+        {
+            ;
+        }
+
+        //! This method performs the encoding.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         @param     input	The input sample.
+         @param     outputs The output array.
+         */
+        inline void process(const T* input, T* outputs) noexcept override
+        {
+            if(!this->m_muted)
+            {
+                outputs[0] = (*input);                      // Hamonic [0,0]
+                Degree<1, false>::process(*input, this->m_cosx, this->m_sinx, this->m_cosx, this->m_sinx, outputs);
+            }
+            else
+            {
+                Signal<T>::clear(2 * N + 1, outputs);
+            }
+        }
+
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa2d, T>::process(inputs, outputs, frames);
+        }
+
+        //! This method performs the encoding.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         @param     input	The input sample.
+         @param     outputs The output array.
+         */
+        inline void processAdd(const T* input, T* outputs) noexcept override
+        {
+            if(!this->m_muted)
+            {
+                outputs[0] += (*input);                     // Hamonic [0,0]
+                Degree<1, true>::process(*input, this->m_cosx, this->m_sinx, this->m_cosx, this->m_sinx, outputs);
+            }
+        }
     };
 
     template <typename T> class Encoder<Hoa2d, T>::DC : public Encoder<Hoa2d, T>
@@ -623,6 +822,17 @@ namespace hoa
             }
         }
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa2d, T>::process(inputs, outputs, frames);
+        }
+
         //! This method performs the encoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
@@ -663,8 +873,46 @@ namespace hoa
     template <typename T> class Encoder<Hoa2d, T>::Multi : public Encoder<Hoa2d, T>
     {
     private:
+        static const ulong              m_chunk = 64ul;
         const ulong                     m_number_of_sources;
         vector<Encoder<Hoa2d, T>::DC*>  m_encoders;
+        typename Optim<Hoa2d, T>::Mode  m_optim;
+        T*                              m_weights;
+        T*                              m_matrix;
+        T*                              m_previous;
+        T*                              m_vectors;
+        const T**                       m_inputs;
+        T**                             m_outputs;
+        bool                            m_started;
+        Partition<T>*                   m_partition;
+
+        //! This method performs the encoding with the interpolation of the matrix.
+        /**	The encoding with the previous matrix is computed in one pass then the difference between the current matrix and the previous matrix is applied chunk by chunk and weighted by a linear ramp.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void ramp(const T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            const ulong size = Encoder<Hoa2d, T>::getNumberOfHarmonics();
+            const T step = T(1.) / T(frames);
+            Signal<T>::mul(m_number_of_sources, size, frames, inputs, m_previous, outputs);
+            Signal<T>::scale(m_number_of_sources * size, -1., m_previous);
+            Signal<T>::add(m_number_of_sources * size, m_matrix, m_previous);
+            for(ulong i = 0; i < frames; i += m_chunk)
+            {
+                const ulong chunk = min(m_chunk, frames - i);
+                for(ulong j = 0; j < m_number_of_sources; j++)
+                {
+                    m_inputs[j] = inputs[j] + i;
+                }
+                Signal<T>::mul(m_number_of_sources, size, chunk, m_inputs, m_previous, m_outputs);
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::rampadd(chunk, T(i + 1) * step, step, m_outputs[j], outputs[j] + i);
+                }
+            }
+        }
     public:
 
         //! The map constructor.
@@ -672,14 +920,28 @@ namespace hoa
 
          @param     order            The order.
          @param     numberOfSources	The number of sources.
+         @param     optim            The optimization.
          */
-        Multi(const ulong order, ulong numberOfSources) noexcept : Encoder<Hoa2d, T>(order),
+        Multi(const ulong order, ulong numberOfSources, const typename Optim<Hoa2d, T>::Mode optim = Optim<Hoa2d, T>::BasicMode) noexcept : Encoder<Hoa2d, T>(order),
         m_number_of_sources(numberOfSources)
         {
             for(ulong i = 0; i < m_number_of_sources; i++)
             {
                 m_encoders.push_back(new Encoder<Hoa2d, T>::DC(order));
             }
+            m_weights   = Signal<T>::alloc(Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix    = Signal<T>::alloc(m_number_of_sources * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_previous  = Signal<T>::alloc(m_number_of_sources * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_vectors   = Signal<T>::alloc(m_chunk * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_inputs    = new const T*[m_number_of_sources];
+            m_outputs   = new T*[Encoder<Hoa2d, T>::getNumberOfHarmonics()];
+            for(ulong i = 0; i < Encoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+            {
+                m_outputs[i] = m_vectors + i * m_chunk;
+            }
+            m_started   = false;
+            m_partition = nullptr;
+            setOptim(optim);
         }
 
         //! The map destructor.
@@ -692,6 +954,28 @@ namespace hoa
                 delete m_encoders[i];
             }
             m_encoders.clear();
+            Signal<T>::free(m_weights);
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_previous);
+            Signal<T>::free(m_vectors);
+            delete [] m_inputs;
+            delete [] m_outputs;
+            delete m_partition;
+        }
+
+        //! This method sets the pool of threads of the vector processing.
+        /**	The sources are divided between the threads of the pool, each thread encodes its sources in its own vectors and the vectors of the threads are summed at the end of the vector processing. The method allocates the vectors of the threads and shouldn't be called during the processing. A null pool disables the parallel processing.
+         @param     pool        The pool of threads or null.
+         @param     vectorsize  The maximum number of samples processed at once, bigger vectors are processed in several parts.
+         */
+        inline void setPool(Pool* pool, const ulong vectorsize) noexcept
+        {
+            delete m_partition;
+            m_partition = nullptr;
+            if(pool && pool->getNumberOfThreads() > 1ul)
+            {
+                m_partition = new Partition<T>(*pool, m_number_of_sources, Encoder<Hoa2d, T>::getNumberOfHarmonics(), vectorsize);
+            }
         }
 
         //! This method retrieve the number of sources.
@@ -704,6 +988,28 @@ namespace hoa
             return m_number_of_sources;
         }
 
+        //! This method sets the optimization of the sources.
+        /**	The weights of the optimization are folded into the harmonics coefficients of the sources, so the harmonics don't need to be optimized after the encoding.
+         @param     mode    The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa2d, T>::Mode mode) noexcept
+        {
+            m_optim = mode;
+            for(ulong i = 0; i < Encoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+            {
+                m_weights[i] = Optim<Hoa2d, T>::getWeight(mode, Encoder<Hoa2d, T>::getDecompositionOrder(), Encoder<Hoa2d, T>::getHarmonicDegree(i));
+            }
+        }
+
+        //! This method retrieves the optimization of the sources.
+        /**	Retrieve the optimization of the sources.
+         @return    The optimization.
+         */
+        inline typename Optim<Hoa2d, T>::Mode getOptim() const noexcept
+        {
+            return m_optim;
+        }
+
         //! This method set the angle of azimuth of a source.
         /**	The angle of azimuth in radian and you should prefer to use it between 0 and 2 π to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The 0 radian is π/2 phase shifted relative to a mathematical representation of a circle, then the 0 radian is at the "front" of the soundfield. The index must be between 0 and the number of sources - 1.
 
@@ -786,11 +1092,66 @@ namespace hoa
             {
                 m_encoders[i]->processAdd(++input, outputs);
             }
+            if(m_optim != Optim<Hoa2d, T>::BasicMode)
+            {
+                for(ulong i = 0; i < Encoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+                {
+                    outputs[i] *= m_weights[i];
+                }
+            }
+        }
+
+        //! This method performs the encoding with distance compensation.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the sources and the minimum size should be the number of sources. The outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The harmonics coefficients of the sources are computed once per vector and the vectors of the sources are summed in the harmonics domain. If the coefficients changed since the previous vector, they are linearly interpolated over the vector so the sources can be moved once per vector without zipper noise.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T factor = 1.;
+            const ulong size = Encoder<Hoa2d, T>::getNumberOfHarmonics();
+            for(ulong i = 0; i < m_number_of_sources; i++)
+            {
+                m_encoders[i]->process(&factor, Encoder<Hoa2d, T>::m_harmonics);
+                for(ulong j = 0; j < size; j++)
+                {
+                    Encoder<Hoa2d, T>::m_harmonics[j] *= m_weights[j];
+                }
+                Signal<T>::copy(size, Encoder<Hoa2d, T>::m_harmonics, 1ul, m_matrix + i, m_number_of_sources);
+            }
+            if(m_started && memcmp(m_matrix, m_previous, m_number_of_sources * size * sizeof(T)))
+            {
+                if(m_partition)
+                {
+                    m_partition->process(inputs, m_previous, m_matrix, outputs, frames);
+                }
+                else
+                {
+                    ramp(inputs, outputs, frames);
+                }
+            }
+            else if(m_partition)
+            {
+                m_partition->process(inputs, m_matrix, outputs, frames);
+            }
+            else
+            {
+                Signal<T>::mul(m_number_of_sources, size, frames, inputs, m_matrix, outputs);
+            }
+            Signal<T>::copy(m_number_of_sources * size, m_matrix, m_previous);
+            m_started = true;
         }
     };
 
+    template <typename T> const ulong Encoder<Hoa2d, T>::Multi::m_chunk;
+
     template <typename T> class Encoder<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
     {
+    private:
+        T*      m_harmonics;
+        T*      m_previous;
+        bool    m_started;
     public:
 
         //! The encoder constructor.
@@ -799,7 +1160,9 @@ namespace hoa
          */
         Encoder(const ulong order) noexcept : Processor<Hoa3d, T>::Harmonics(order)
         {
-            ;
+            m_harmonics = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
+            m_previous  = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
+            m_started   = false;
         }
 
         //! The encoder destructor.
@@ -807,7 +1170,8 @@ namespace hoa
          */
         virtual ~Encoder() noexcept
         {
-
+            Signal<T>::free(m_harmonics);
+            Signal<T>::free(m_previous);
         }
 
         //! This method performs the encoding.
@@ -817,6 +1181,37 @@ namespace hoa
          */
         virtual void process(const T* input, T* outputs) noexcept = 0;
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The harmonics coefficients are computed once per vector and, if they changed since the previous vector, they are linearly interpolated over the vector so the source can be moved once per vector without zipper noise. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T factor = 1.;
+            const ulong size = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            process(&factor, m_harmonics);
+            if(m_started && memcmp(m_harmonics, m_previous, size * sizeof(T)))
+            {
+                const T step = T(1.) / T(frames);
+                for(ulong i = size; i; i--)
+                {
+                    const T delta = (m_harmonics[i-1] - m_previous[i-1]) * step;
+                    Signal<T>::ramp(frames, m_previous[i-1] + delta, delta, inputs[0], outputs[i-1]);
+                }
+            }
+            else
+            {
+                for(ulong i = size; i; i--)
+                {
+                    Signal<T>::scale(frames, m_harmonics[i-1], inputs[0], outputs[i-1]);
+                }
+            }
+            Signal<T>::copy(size, m_harmonics, m_previous);
+            m_started = true;
+        }
+
         //! The basic encoder class generates the harmonics for one signal according to an azimuth and an elevation.
         /** The basic encoder should be used to encode a signal in the harmonics domain depending on an order of decomposition. It allows to control the azimuth and the elevation of the signal.
          */
@@ -828,7 +1223,7 @@ namespace hoa
         class DC;
 
         //! The multi encoder class generates the harmonics for several signals according to an azimuth, an elevation and a radius for each one.
-        /** The multi encoder should be used to encode several signals in the harmonics domain depending on an order of decomposition. It allows to control the azimuth, the elevation and the radius of each signal. The class uses a set of dc encoders.
+        /** The multi encoder should be used to encode several signals in the harmonics domain depending on an order of decomposition. It allows to control the azimuth, the elevation and the radius of each signal. The class performs the recurrences of the dc encoder for several sources at once with the values of the sources stored in contiguous arrays.
          */
         class Multi;
     };
@@ -842,7 +1237,7 @@ namespace hoa
         T  m_sin_phi;
         T  m_cos_theta;
         T  m_sqrt_rmin;
-        T* m_normalization;
+        const T* m_normalization;
         bool m_muted;
     public:
 
@@ -852,11 +1247,7 @@ namespace hoa
          */
         Basic(const ulong order) noexcept : Encoder<Hoa3d, T>(order)
         {
-            m_normalization = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
-            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
-            {
-                m_normalization[i] = Processor<Hoa3d, T>::Harmonics::getHarmonicSemiNormalization(i);
-            }
+            m_normalization = Harmonic<Hoa3d, T>::acquireSemiNormalizations(order);
             setMute(false);
             setAzimuth(0.);
             setElevation(0.);
@@ -867,7 +1258,7 @@ namespace hoa
          */
         ~Basic() noexcept
         {
-            Signal<T>::free(m_normalization);
+            Harmonic<Hoa3d, T>::releaseSemiNormalizations(m_normalization);
         }
 
         //! This method mute or unmute.
@@ -1031,6 +1422,17 @@ namespace hoa
             }
         }
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa3d, T>::process(inputs, outputs, frames);
+        }
+
         //! This method performs the encoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. For the elevation, the function uses three recurrence formulas :
          \f[P(l, l)(x) = (-1)^l \times (2l - 1)!! \times (1 - x^2)^{0.5l}\f]
@@ -1045,7 +1447,7 @@ namespace hoa
          @param     input    The input sample.
          @param     outputs  The outputs array.
          */
-        void processAdd(const T* input, T* outputs) noexcept
+        virtual void processAdd(const T* input, T* outputs) noexcept
         {
             if(!m_muted)
             {
@@ -1123,12 +1525,192 @@ namespace hoa
                 index += 2 * order;
                 *(outputs+index) += (*input) * leg_l2 * cos_x * *(norm+index);
             }
-            else
+        }
+
+        //! The fixed basic encoder class generates the harmonics for one signal with an order of decomposition known at compile time.
+        /** The fixed basic encoder performs the same encoding as the basic encoder but the recurrences of the associated Legendre polynomials and of the azimuth are unrolled at compile time and the normalizations are constant expressions.
+         */
+        template <ulong N> class Fixed;
+
+        //! This method creates a basic encoder.
+        /**	This method creates a fixed basic encoder for the orders 1 to 7 and a basic encoder for the higher orders. The encoder must be deleted by the caller.
+         @param     order	The order.
+         @return    The basic encoder.
+         */
+        static Basic* create(const ulong order)
+        {
+            switch(order)
             {
-                for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+                case 1: return new Fixed<1>();
+                case 2: return new Fixed<2>();
+                case 3: return new Fixed<3>();
+                case 4: return new Fixed<4>();
+                case 5: return new Fixed<5>();
+                case 6: return new Fixed<6>();
+                case 7: return new Fixed<7>();
+                default: return new Basic(order);
+            }
+        }
+    };
+
+    template <typename T> template <ulong N> class Encoder<Hoa3d, T>::Basic::Fixed : public Encoder<Hoa3d, T>::Basic
+    {
+    private:
+
+        //! The ratio of the factorials (l - m)! / (l + m)!.
+        static constexpr double ratio(const ulong l, const ulong m) noexcept
+        {
+            return m == 0 ? 1. : ratio(l, m - 1) / double((l + m) * (l - m + 1));
+        }
+
+        //! The square root with the Newton's method.
+        static constexpr double root(const double x, const double y, const ulong n) noexcept
+        {
+            return n == 0 ? y : root(x, 0.5 * (y + x / y), n - 1);
+        }
+
+        //! The semi-normalization of the harmonics with an order different from zero, the zonal harmonics aren't normalized.
+        static constexpr double normalization(const ulong l, const ulong m) noexcept
+        {
+            return m == 0 ? 1. : root(ratio(l, m) / (2. * HOA_PI), 1., 64);
+        }
+
+        //! The unrolled recurrence of the harmonics of order ±M and of degree L and above.
+        // P(l,m) = (x(2l-1)P(l-1,m) - (l+m-1)P(l-2,m))/(l-m)
+        template <ulong L, ulong M, bool Add, bool End = (L > N)> struct Degree
+        {
+            static constexpr T norm = T(normalization(L, M));
+
+            static inline void process(const T input, const T x, const T cos_m, const T sin_m, const T p1, const T p2, T* outputs) noexcept
+            {
+                const T p = (x * T(2 * L - 1) * p1 - T(L + M - 1) * p2) * T(1. / double(L - M));
+                if(Add)
                 {
-                    (*outputs++) = 0.;
+                    outputs[L * L + L + M] += input * p * cos_m * norm;         // Hamonic [L, M]
+                    if(M)
+                    {
+                        outputs[L * L + L - M] += input * p * sin_m * norm;     // Hamonic [L,-M]
+                    }
                 }
+                else
+                {
+                    outputs[L * L + L + M] = input * p * cos_m * norm;          // Hamonic [L, M]
+                    if(M)
+                    {
+                        outputs[L * L + L - M] = input * p * sin_m * norm;      // Hamonic [L,-M]
+                    }
+                }
+                Degree<L + 1, M, Add>::process(input, x, cos_m, sin_m, p, p1, outputs);
+            }
+        };
+
+        template <ulong L, ulong M, bool Add> struct Degree<L, M, Add, true>
+        {
+            static inline void process(const T, const T, const T, const T, const T, const T, T*) noexcept {}
+        };
+
+        //! The unrolled recurrence of the harmonics of order ±M and above.
+        // P(m,m) = -(2m-1)√(1-x²)P(m-1,m-1)
+        template <ulong M, bool Add, bool End = (M > N)> struct Order
+        {
+            static constexpr T norm = T(normalization(M, M));
+
+            static inline void process(const T input, const T x, const T y, const T cosx, const T sinx, const T cos_m, const T sin_m, const T pmm, T* outputs) noexcept
+            {
+                const T p = y * T(2 * M - 1) * pmm;
+                if(Add)
+                {
+                    outputs[M * M + 2 * M] += input * p * cos_m * norm;         // Hamonic [M, M]
+                    outputs[M * M]         += input * p * sin_m * norm;         // Hamonic [M,-M]
+                }
+                else
+                {
+                    outputs[M * M + 2 * M] = input * p * cos_m * norm;          // Hamonic [M, M]
+                    outputs[M * M]         = input * p * sin_m * norm;          // Hamonic [M,-M]
+                }
+                Degree<M + 1, M, Add>::process(input, x, cos_m, sin_m, p, 0., outputs);
+                Order<M + 1, Add>::process(input, x, y, cosx, sinx, cos_m * cosx - sin_m * sinx, cos_m * sinx + sin_m * cosx, p, outputs);
+            }
+        };
+
+        template <ulong M, bool Add> struct Order<M, Add, true>
+        {
+            static inline void process(const T, const T, const T, const T, const T, const T, const T, const T, T*) noexcept {}
+        };
+
+        template <bool Add> inline void encode(const T input, T* outputs) const noexcept
+        {
+            const bool front  = (this->m_elevation >= -HOA_PI2 && this->m_elevation <= HOA_PI2);
+            const T cos_phi   = front ? this->m_cos_phi : -this->m_cos_phi;
+            const T sin_phi   = front ? this->m_sin_phi : -this->m_sin_phi;
+            if(Add)
+            {
+                outputs[0] += input;                        // Hamonic [0, 0]
+            }
+            else
+            {
+                outputs[0] = input;                         // Hamonic [0, 0]
+            }
+            Degree<1, 0, Add>::process(input, this->m_cos_theta, 1., 0., 1., 0., outputs);
+            Order<1, Add>::process(input, this->m_cos_theta, -this->m_sqrt_rmin, cos_phi, sin_phi, cos_phi, sin_phi, 1., outputs);
+        }
+
+    public:
+
+        //! The fixed encoder constructor.
+        /**	The fixed encoder constructor allocates and initialize the member values to computes spherical harmonics coefficients for the encoding.
+         */
+        Fixed() noexcept : Encoder<Hoa3d, T>::Basic(N)
+        {
+            static_assert(N > 0, "The order must be at least 1.");
+        }
+
+        //! The fixed encoder destructor.
+        /**	The fixed encoder destructor free the memory.
+         */
+        ~Fixed() noexcept
+        {
+            ;
+        }
+
+        //! This method performs the encoding.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         @param     input    The input sample.
+         @param     outputs  The outputs array.
+         */
+        inline void process(const T* input, T* outputs) noexcept override
+        {
+            if(!this->m_muted)
+            {
+                encode<false>(*input, outputs);
+            }
+            else
+            {
+                Signal<T>::clear((N + 1) * (N + 1), outputs);
+            }
+        }
+
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa3d, T>::process(inputs, outputs, frames);
+        }
+
+        //! This method performs the encoding but add the result to the outputs.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+         @param     input    The input sample.
+         @param     outputs  The outputs array.
+         */
+        inline void processAdd(const T* input, T* outputs) noexcept override
+        {
+            if(!this->m_muted)
+            {
+                encode<true>(*input, outputs);
             }
         }
     };
@@ -1143,7 +1725,7 @@ namespace hoa
         T  m_cos_theta;
         T  m_sqrt_rmin;
         T  m_radius;
-        T* m_normalization;
+        const T* m_normalization;
         T* m_distance;
         bool m_muted;
     public:
@@ -1154,12 +1736,8 @@ namespace hoa
          */
         DC(const ulong order) noexcept : Encoder<Hoa3d, T>(order)
         {
-            m_normalization = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
-            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
-            {
-                m_normalization[i] = Processor<Hoa3d, T>::Harmonics::getHarmonicSemiNormalization(i);
-            }
-            m_distance = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder());
+            m_normalization = Harmonic<Hoa3d, T>::acquireSemiNormalizations(order);
+            m_distance = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() + 1);
             setMute(false);
             setAzimuth(0.);
             setElevation(0.);
@@ -1171,7 +1749,7 @@ namespace hoa
          */
         ~DC() noexcept
         {
-            Signal<T>::free(m_normalization);
+            Harmonic<Hoa3d, T>::releaseSemiNormalizations(m_normalization);
             Signal<T>::free(m_distance);
 
         }
@@ -1373,6 +1951,17 @@ namespace hoa
             }
         }
 
+        //! This method performs the encoding.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vector of the signal and the outputs array contains the vectors of the harmonics, the minimum size must be the number of harmonics. The vector of the signal can be the vector of the first harmonic.
+         @param     inputs   The input vector.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Encoder<Hoa3d, T>::process(inputs, outputs, frames);
+        }
+
         //! This method performs the encoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          // cos(x + b) = cos(x) * cos(b) - sin(x) * sin(b)
@@ -1465,8 +2054,240 @@ namespace hoa
     template <typename T> class Encoder<Hoa3d, T>::Multi : public Encoder<Hoa3d, T>
     {
     private:
-        const ulong                     m_number_of_sources;
-        vector<Encoder<Hoa3d, T>::DC *> m_encoders;
+        static const ulong  m_lanes = 8ul;
+        static const ulong  m_chunk = 64ul;
+        const ulong         m_number_of_sources;
+        const ulong         m_number_of_lanes;
+        T*                  m_azimuth;
+        T*                  m_elevation;
+        T*                  m_radius;
+        T*                  m_cos_phi;
+        T*                  m_sin_phi;
+        T*                  m_cos_theta;
+        T*                  m_sqr_theta;
+        T*                  m_gain;
+        T*                  m_distance;
+        typename Optim<Hoa3d, T>::Mode m_optim;
+        T*                  m_weights;
+        const T*            m_normalization;
+        T*                  m_coefficients;
+        T*                  m_matrix;
+        T*                  m_previous;
+        T*                  m_vectors;
+        const T**           m_inputs;
+        T**                 m_outputs;
+        bool                m_changed;
+        bool                m_started;
+        Partition<T>*       m_partition;
+
+        //! This method performs the encoding with the interpolation of the matrix.
+        /**	The encoding with the previous matrix is computed in one pass then the difference between the current matrix and the previous matrix is applied chunk by chunk and weighted by a linear ramp.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void ramp(const T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            const ulong size = Encoder<Hoa3d, T>::getNumberOfHarmonics();
+            const T step = T(1.) / T(frames);
+            Signal<T>::mul(m_number_of_sources, size, frames, inputs, m_previous, outputs);
+            Signal<T>::scale(m_number_of_sources * size, -1., m_previous);
+            Signal<T>::add(m_number_of_sources * size, m_matrix, m_previous);
+            for(ulong i = 0; i < frames; i += m_chunk)
+            {
+                const ulong chunk = min(m_chunk, frames - i);
+                for(ulong j = 0; j < m_number_of_sources; j++)
+                {
+                    m_inputs[j] = inputs[j] + i;
+                }
+                Signal<T>::mul(m_number_of_sources, size, chunk, m_inputs, m_previous, m_outputs);
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::rampadd(chunk, T(i + 1) * step, step, m_outputs[j], outputs[j] + i);
+                }
+            }
+        }
+
+        //! This method computes the trigonometric values of a source.
+        /**	The azimuth is reversed when the elevation is between π/2 and 3π/2.
+         @param     index	The index of the source.
+         */
+        inline void computeAngles(const ulong index) noexcept
+        {
+            const T elevation = m_elevation[index];
+            const T sign = (elevation >= -HOA_PI2 && elevation <= HOA_PI2) ? T(1.) : T(-1.);
+            m_cos_phi[index]    = sign * std::cos(m_azimuth[index]);
+            m_sin_phi[index]    = sign * std::sin(m_azimuth[index]);
+            m_cos_theta[index]  = std::cos(HOA_PI2 + elevation);
+            m_sqr_theta[index]  = -std::sqrt(1 - m_cos_theta[index] * m_cos_theta[index]);
+            m_changed = true;
+        }
+
+        //! This method computes the distance compensation of a source.
+        /**	The distance compensation of each degree is stored in the row of the degree.
+         @param     index	The index of the source.
+         */
+        inline void computeDistance(const ulong index) noexcept
+        {
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            const T radius = m_radius[index];
+            T factor, gain, dist;
+            if(radius < 1.)
+            {
+                factor      = (1. - radius) * HOA_PI;
+                gain        = (sin(factor - HOA_PI2) + 1.) * 0.5;
+                dist        = 1.;
+            }
+            else
+            {
+                factor      = 0;
+                gain        = 0;
+                dist        = 1. / radius;
+            }
+
+            const T gain1   = (gain * order);
+            m_distance[index] = (gain1 + dist);
+            m_distance[m_number_of_lanes + index] = (cos(Math<T>::clip(factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain1 - gain) + dist);
+            for(ulong i = 2; i <= order; i++)
+            {
+                const T gain2   = (gain * (order - i) + dist);
+                const T factor1 = (cos(Math<T>::clip(factor * i, 0., HOA_PI)) + 1.) * 0.5;
+                m_distance[i * m_number_of_lanes + index] = factor1 * gain2;
+            }
+            m_changed = true;
+        }
+
+        //! This method computes the coefficients of a lane of sources for an harmonic.
+        /**	The coefficients are the product of the Legendre terms, the azimuth terms, the normalization, the weight of the optimization and the distance compensation. As for the dc encoder, the harmonics of order 0 aren't normalized.
+         @param     index   The index of the harmonic.
+         @param     first   The index of the first source of the lane.
+         @param     leg     The Legendre terms of the lane.
+         @param     azi     The azimuth terms of the lane.
+         @param     degree  The degree of the harmonic.
+         */
+        inline void computeHarmonic(const ulong index, const ulong first, const T* leg, const T* azi, const ulong degree) noexcept
+        {
+            const T norm    = ((index == degree * (degree + 1)) ? T(1.) : m_normalization[index]) * m_weights[degree];
+            const T* dist   = m_distance + degree * m_number_of_lanes + first;
+            const T* gain   = m_gain + first;
+            T* output       = m_coefficients + index * m_number_of_lanes + first;
+            for(ulong k = 0; k < m_lanes; k++)
+            {
+                output[k] = leg[k] * azi[k] * norm * dist[k] * gain[k];
+            }
+        }
+
+        //! This method computes the coefficients of the sources.
+        /**	The recurrences of the dc encoder are performed for several sources at once, the sources are grouped in lanes of 8 sources and the values of a lane are stored contiguously so each step of the recurrences can be vectorized.
+         */
+        void computeMatrix() noexcept
+        {
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            T ones[m_lanes], leg_l1[m_lanes], leg_l2[m_lanes], pleg_l[m_lanes], cos_x[m_lanes], sin_x[m_lanes];
+            for(ulong k = 0; k < m_lanes; k++)
+            {
+                ones[k] = 1.;
+            }
+            for(ulong first = 0; first < m_number_of_lanes; first += m_lanes)
+            {
+                const T* cos_theta = m_cos_theta + first;
+                const T* sqr_theta = m_sqr_theta + first;
+                const T* cos_phi   = m_cos_phi + first;
+                const T* sin_phi   = m_sin_phi + first;
+
+                // For m[0] and l{0...N}
+                for(ulong k = 0; k < m_lanes; k++)
+                {
+                    leg_l2[k] = 1.;
+                    leg_l1[k] = cos_theta[k];
+                }
+                computeHarmonic(0, first, leg_l2, ones, 0);             // Hamonic [0, 0]
+                computeHarmonic(2, first, leg_l1, ones, 1);             // Hamonic [1, 0]
+                ulong index = 6;
+                for(ulong i = 2; i <= order; i++, index += 2 * i)
+                {
+                    const T f1 = T(2 * (i - 1) + 1) / T(i), f2 = T(i - 1) / T(i);
+                    for(ulong k = 0; k < m_lanes; k++)
+                    {
+                        const T tleg_l = cos_theta[k] * leg_l1[k] * f1 - f2 * leg_l2[k];
+                        leg_l2[k] = leg_l1[k];
+                        leg_l1[k] = tleg_l;
+                    }
+                    computeHarmonic(index, first, leg_l1, ones, i);     // Hamonic [i, 0]
+                }
+
+                // For m{1...N-1} and l{m...N}
+                for(ulong k = 0; k < m_lanes; k++)
+                {
+                    pleg_l[k] = 1.;
+                    cos_x[k] = cos_phi[k];
+                    sin_x[k] = sin_phi[k];
+                }
+                index = 1;
+                for(ulong i = 1; i < order; i++, index = i * i)
+                {
+                    ulong inc = 2;
+                    const T f1 = T(2 * (i - 1) + 1), f2 = T(2 * i + 1);
+                    for(ulong k = 0; k < m_lanes; k++)
+                    {
+                        leg_l2[k] = sqr_theta[k] * pleg_l[k] * f1;
+                        leg_l1[k] = cos_theta[k] * leg_l2[k] * f2;
+                        pleg_l[k] = leg_l2[k];
+                    }
+
+                    computeHarmonic(index, first, leg_l2, sin_x, i);    // Hamonic [i,-i]
+                    index += 2*i;
+                    computeHarmonic(index, first, leg_l2, cos_x, i);    // Hamonic [i, i]
+                    index += inc;
+
+                    computeHarmonic(index, first, leg_l1, sin_x, i+1);  // Hamonic [i+1,-i]
+                    index += 2*i;
+                    computeHarmonic(index, first, leg_l1, cos_x, i+1);  // Hamonic [i+1, i]
+                    inc += 2;
+                    index += inc;
+
+                    for(ulong j = i + 2; j <= order; j++)
+                    {
+                        const T f3 = T(2 * (j - 1) + 1) / T(j - i), f4 = T(j - 1 + i) / T(j - i);
+                        for(ulong k = 0; k < m_lanes; k++)
+                        {
+                            const T tleg_l = cos_theta[k] * leg_l1[k] * f3 - f4 * leg_l2[k];
+                            leg_l2[k] = leg_l1[k];
+                            leg_l1[k] = tleg_l;
+                        }
+
+                        computeHarmonic(index, first, leg_l1, sin_x, j); // Hamonic [j,-i]
+                        index += 2*i;
+                        computeHarmonic(index, first, leg_l1, cos_x, j); // Hamonic [j, i]
+                        inc += 2;
+                        index += inc;
+                    }
+                    for(ulong k = 0; k < m_lanes; k++)
+                    {
+                        const T tcos_x = cos_x[k];
+                        cos_x[k] = tcos_x * cos_phi[k] - sin_x[k] * sin_phi[k];
+                        sin_x[k] = tcos_x * sin_phi[k] + sin_x[k] * cos_phi[k];
+                    }
+                }
+
+                // For m[N] and l[N]
+                index = order * order;
+                const T f1 = T(2 * (order - 1) + 1);
+                for(ulong k = 0; k < m_lanes; k++)
+                {
+                    leg_l2[k] = sqr_theta[k] * pleg_l[k] * f1;
+                }
+                computeHarmonic(index, first, leg_l2, sin_x, order);
+                index += 2 * order;
+                computeHarmonic(index, first, leg_l2, cos_x, order);
+            }
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                Signal<T>::copy(m_number_of_sources, m_coefficients + i * m_number_of_lanes, m_matrix + i * m_number_of_sources);
+            }
+            m_changed = false;
+        }
+
     public:
 
         //! The map constructor.
@@ -1474,13 +2295,42 @@ namespace hoa
 
          @param     order            The order.
          @param     numberOfSources	The number of sources.
-         */
-        Multi(const ulong order, ulong numberOfSources) noexcept : Encoder<Hoa3d, T>(order),
-        m_number_of_sources(numberOfSources)
-        {
+         @param     optim            The optimization.
+         */
+        Multi(const ulong order, ulong numberOfSources, const typename Optim<Hoa3d, T>::Mode optim = Optim<Hoa3d, T>::BasicMode) noexcept : Encoder<Hoa3d, T>(order),
+        m_number_of_sources(numberOfSources),
+        m_number_of_lanes(((numberOfSources + m_lanes - 1) / m_lanes) * m_lanes)
+        {
+            m_azimuth       = Signal<T>::alloc(m_number_of_lanes);
+            m_elevation     = Signal<T>::alloc(m_number_of_lanes);
+            m_radius        = Signal<T>::alloc(m_number_of_lanes);
+            m_cos_phi       = Signal<T>::alloc(m_number_of_lanes);
+            m_sin_phi       = Signal<T>::alloc(m_number_of_lanes);
+            m_cos_theta     = Signal<T>::alloc(m_number_of_lanes);
+            m_sqr_theta     = Signal<T>::alloc(m_number_of_lanes);
+            m_gain          = Signal<T>::alloc(m_number_of_lanes);
+            m_distance      = Signal<T>::alloc((order + 1) * m_number_of_lanes);
+            m_weights       = Signal<T>::alloc(order + 1);
+            m_normalization = Harmonic<Hoa3d, T>::acquireSemiNormalizations(order);
+            m_coefficients  = Signal<T>::alloc(m_number_of_lanes * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_matrix        = Signal<T>::alloc(m_number_of_sources * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_previous      = Signal<T>::alloc(m_number_of_sources * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_vectors       = Signal<T>::alloc(m_chunk * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_inputs        = new const T*[m_number_of_sources];
+            m_outputs       = new T*[Encoder<Hoa3d, T>::getNumberOfHarmonics()];
+            m_started       = false;
+            m_partition     = nullptr;
+            setOptim(optim);
+            for(ulong i = 0; i < Encoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
+            {
+                m_outputs[i] = m_vectors + i * m_chunk;
+            }
             for(ulong i = 0; i < m_number_of_sources; i++)
             {
-                m_encoders.push_back(new Encoder<Hoa3d, T>::DC(order));
+                m_gain[i]   = 1.;
+                m_radius[i] = 1.;
+                computeAngles(i);
+                computeDistance(i);
             }
         }
 
@@ -1489,11 +2339,62 @@ namespace hoa
          */
         ~Multi() noexcept
         {
-            for(ulong i = 0; i < m_number_of_sources; i++)
+            Signal<T>::free(m_azimuth);
+            Signal<T>::free(m_elevation);
+            Signal<T>::free(m_radius);
+            Signal<T>::free(m_cos_phi);
+            Signal<T>::free(m_sin_phi);
+            Signal<T>::free(m_cos_theta);
+            Signal<T>::free(m_sqr_theta);
+            Signal<T>::free(m_gain);
+            Signal<T>::free(m_distance);
+            Signal<T>::free(m_weights);
+            Harmonic<Hoa3d, T>::releaseSemiNormalizations(m_normalization);
+            Signal<T>::free(m_coefficients);
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_previous);
+            Signal<T>::free(m_vectors);
+            delete [] m_inputs;
+            delete [] m_outputs;
+            delete m_partition;
+        }
+
+        //! This method sets the pool of threads of the vector processing.
+        /**	The sources are divided between the threads of the pool, each thread encodes its sources in its own vectors and the vectors of the threads are summed at the end of the vector processing. The method allocates the vectors of the threads and shouldn't be called during the processing. A null pool disables the parallel processing.
+         @param     pool        The pool of threads or null.
+         @param     vectorsize  The maximum number of samples processed at once, bigger vectors are processed in several parts.
+         */
+        inline void setPool(Pool* pool, const ulong vectorsize) noexcept
+        {
+            delete m_partition;
+            m_partition = nullptr;
+            if(pool && pool->getNumberOfThreads() > 1ul)
             {
-                delete m_encoders[i];
+                m_partition = new Partition<T>(*pool, m_number_of_sources, Encoder<Hoa3d, T>::getNumberOfHarmonics(), vectorsize);
             }
-            m_encoders.clear();
+        }
+
+        //! This method sets the optimization of the sources.
+        /**	The weights of the optimization are folded into the harmonics coefficients of the sources, so the harmonics don't need to be optimized after the encoding.
+         @param     mode    The optimization.
+         */
+        inline void setOptim(const typename Optim<Hoa3d, T>::Mode mode) noexcept
+        {
+            m_optim = mode;
+            for(ulong i = 0; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
+            {
+                m_weights[i] = Optim<Hoa3d, T>::getWeight(mode, Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(), i);
+            }
+            m_changed = true;
+        }
+
+        //! This method retrieves the optimization of the sources.
+        /**	Retrieve the optimization of the sources.
+         @return    The optimization.
+         */
+        inline typename Optim<Hoa3d, T>::Mode getOptim() const noexcept
+        {
+            return m_optim;
         }
 
         //! This method retrieve the number of sources.
@@ -1515,7 +2416,8 @@ namespace hoa
          */
         inline void setAzimuth(const ulong index, const T azimuth) noexcept
         {
-            m_encoders[index]->setAzimuth(azimuth);
+            m_azimuth[index] = azimuth;
+            computeAngles(index);
         }
 
         //! This method set the angle of azimuth of a source.
@@ -1527,7 +2429,8 @@ namespace hoa
          */
         inline void setElevation(const ulong index, const T elevation) noexcept
         {
-            m_encoders[index]->setElevation(elevation);
+            m_elevation[index] = elevation;
+            computeAngles(index);
         }
 
         //! This method set the radius of a source.
@@ -1539,7 +2442,8 @@ namespace hoa
          */
         inline void setRadius(const ulong index, const T radius) noexcept
         {
-            m_encoders[index]->setRadius(radius);
+            m_radius[index] = max(radius, (T)0.);
+            computeDistance(index);
         }
 
         //! This method mute or unmute a source.
@@ -1550,7 +2454,8 @@ namespace hoa
          */
         inline void setMute(const ulong index, const bool muted) noexcept
         {
-            m_encoders[index]->setMute(muted);
+            m_gain[index] = muted ? T(0.) : T(1.);
+            m_changed = true;
         }
 
         //! This method retrieve the azimuth of a source.
@@ -1561,7 +2466,7 @@ namespace hoa
          */
         inline T getAzimuth(const ulong index) const noexcept
         {
-            return m_encoders[index]->getAzimuth();
+            return Math<T>::wrap_twopi(m_azimuth[index]);
         }
 
         //! This method retrieve the elevation of a source.
@@ -1572,7 +2477,7 @@ namespace hoa
          */
         inline T getElevation(const ulong index) const noexcept
         {
-            return m_encoders[index]->getElevation();
+            return Math<T>::wrap_pi(m_elevation[index]);
         }
 
         //! This method retrieve the radius of a source.
@@ -1583,7 +2488,7 @@ namespace hoa
          */
         inline T getRadius(const ulong index) const noexcept
         {
-            return m_encoders[index]->getRadius();
+            return m_radius[index];
         }
 
         //! This method retrieve the mute or unmute state of a source.
@@ -1595,25 +2500,70 @@ namespace hoa
          */
         inline bool getMute(const ulong index) const noexcept
         {
-            return m_encoders[index]->getMute();
+            return m_gain[index] == T(0.);
         }
 
 
         //! This method performs the encoding with distance compensation.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The input array contains the samples of the sources and the minimum size should be the number of sources. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+        /**	You should use this method for not-in-place processing and sample by sample. The input array contains the samples of the sources and the minimum size should be the number of sources. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. The harmonics coefficients of the sources are only computed after a change of the azimuth, the elevation, the radius or the mute state of a source.
          @param     input  The input array.
          @param     outputs The outputs array.
          */
         inline void process(const T* input, T* outputs) noexcept override
         {
-            m_encoders[0]->process(input, outputs);
-            for(ulong i = 1; i < m_number_of_sources; i++)
+            if(m_changed)
             {
-                m_encoders[i]->processAdd(++input, outputs);
+                computeMatrix();
+                Signal<T>::copy(m_number_of_sources * Encoder<Hoa3d, T>::getNumberOfHarmonics(), m_matrix, m_previous);
             }
+            Signal<T>::mul(m_number_of_sources, Encoder<Hoa3d, T>::getNumberOfHarmonics(), input, m_matrix, outputs);
+        }
+
+        //! This method performs the encoding with distance compensation.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the sources and the minimum size should be the number of sources. The outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The vectors of the sources are summed in the harmonics domain. After a change of the azimuth, the elevation, the radius or the mute state of a source, the harmonics coefficients are linearly interpolated over the vector so the sources can be moved once per vector without zipper noise.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = m_number_of_sources * Encoder<Hoa3d, T>::getNumberOfHarmonics();
+            if(m_changed)
+            {
+                computeMatrix();
+                if(m_started && m_partition)
+                {
+                    m_partition->process(inputs, m_previous, m_matrix, outputs, frames);
+                }
+                else if(m_started)
+                {
+                    ramp(inputs, outputs, frames);
+                }
+                else if(m_partition)
+                {
+                    m_partition->process(inputs, m_matrix, outputs, frames);
+                }
+                else
+                {
+                    Signal<T>::mul(m_number_of_sources, Encoder<Hoa3d, T>::getNumberOfHarmonics(), frames, inputs, m_matrix, outputs);
+                }
+                Signal<T>::copy(size, m_matrix, m_previous);
+            }
+            else if(m_partition)
+            {
+                m_partition->process(inputs, m_matrix, outputs, frames);
+            }
+            else
+            {
+                Signal<T>::mul(m_number_of_sources, Encoder<Hoa3d, T>::getNumberOfHarmonics(), frames, inputs, m_matrix, outputs);
+            }
+            m_started = true;
         }
     };
 
+    template <typename T> const ulong Encoder<Hoa3d, T>::Multi::m_lanes;
+    template <typename T> const ulong Encoder<Hoa3d, T>::Multi::m_chunk;
+
 #endif
 }
 
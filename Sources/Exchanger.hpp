@@ -61,6 +61,29 @@ namespace hoa
          */
         virtual void process(T const* inputs, T* outputs) noexcept;
 
+        //! This method performs the numbering and the normalization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the spherical harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept;
+
+        //! This method performs the numbering and the normalization by remapping the vectors.
+        /**	You should use this method for vector by vector processing when the vectors don't need to be copied. The outputs array receives the pointers of the input vectors in the output numbering and only the vectors whose normalization changes are scaled in place.
+         @param     inputs   The input vectors.
+         @param     outputs  The array of the output vectors pointers.
+         @param     frames   The number of samples of the vectors.
+         */
+        void remap(T** inputs, T** outputs, const ulong frames) noexcept;
+
+        //! Checks if an harmonic is unchanged by the conversion.
+        /**	An harmonic is unchanged if the output takes the input at the same index without any scaling.
+         @param     index	The index of the harmonic.
+         @return    True if the harmonic is unchanged.
+         */
+        bool isUnchanged(const ulong index) const noexcept;
+
         //! Sets the numbering conversion.
         /**	This method sets the numbering conversion.
          @param mode The numbering convertion.
@@ -142,19 +165,69 @@ namespace hoa
         };
 
     private:
+        static const ulong m_chunk = 64ul;
         Numbering       m_numbering;
         Normalization   m_normalization;
+        ulong*          m_indices;
+        T*              m_factors;
+        T*              m_vector;
+
+        //! Get the index of an harmonic in the Furse-Malham numbering.
+        /** The Furse-Malham numbering is only defined up to the order 3, the harmonics of higher degrees keep their ACN index.
+         @param     index	The index of the harmonic in the ACN numbering.
+         @return    The index of the harmonic in the Furse-Malham numbering.
+         */
+        static inline ulong getFurseMalhamIndex(const ulong index) noexcept
+        {
+            return (index && index < 7ul) ? ((index % 2ul) ? index + 1ul : index - 1ul) : index;
+        }
+
+        //! Get the index of an harmonic in the SID numbering.
+        /** Get the index of an harmonic in the SID numbering.
+         @param     index	The index of the harmonic in the ACN numbering.
+         @return    The index of the harmonic in the SID numbering.
+         */
+        static inline ulong getSIDIndex(const ulong index) noexcept
+        {
+            return index ? ((index % 2ul) ? index + 1ul : index - 1ul) : index;
+        }
+
+        //! Compute the indices and the factors of the conversion.
+        /** The numbering and the normalization conversions are merged into a single gathering, each output takes an input weighted by a factor.
+         */
+        void compute() noexcept
+        {
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const ulong input   = (m_numbering == fromFurseMalham) ? getFurseMalhamIndex(i) : ((m_numbering == fromSID) ? getSIDIndex(i) : i);
+                const ulong output  = (m_numbering == toFurseMalham) ? getFurseMalhamIndex(i) : ((m_numbering == toSID) ? getSIDIndex(i) : i);
+                T factor = 1.;
+                if(i == 0 && m_normalization == fromMaxN)
+                {
+                    factor = T(sqrt(2.));
+                }
+                else if(i == 0 && m_normalization == toMaxN)
+                {
+                    factor = T(1. / sqrt(2.));
+                }
+                m_indices[output] = input;
+                m_factors[output] = factor;
+            }
+        }
     public:
 
         //! The exchanger constructor.
-        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1 and should be 3 at maximum.
+        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1. The Furse-Malham numbering is only defined up to the order 3, the harmonics of higher degrees keep their ACN index.
          @param     order	The order.
          */
         inline Exchanger(const ulong order) noexcept : Processor<Hoa2d, T>::Harmonics(order),
         m_numbering(ACN),
         m_normalization(SN2D)
         {
-            ;
+            m_indices   = new ulong[Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics()];
+            m_factors   = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_vector    = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() * m_chunk);
+            compute();
         }
 
         //! The exchanger destructor.
@@ -162,7 +235,9 @@ namespace hoa
          */
         inline ~Exchanger() noexcept
         {
-            ;
+            delete [] m_indices;
+            Signal<T>::free(m_factors);
+            Signal<T>::free(m_vector);
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -172,6 +247,7 @@ namespace hoa
         {
             m_numbering = fromFurseMalham;
             m_normalization = fromMaxN;
+            compute();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -181,6 +257,7 @@ namespace hoa
         {
             m_numbering = toFurseMalham;
             m_normalization = toMaxN;
+            compute();
         }
 
         //! Sets the numbering conversion.
@@ -190,6 +267,7 @@ namespace hoa
         inline void setNumbering(const Numbering mode) noexcept
         {
             m_numbering = mode;
+            compute();
         }
 
         //! Gets the numbering conversion.
@@ -208,6 +286,7 @@ namespace hoa
         inline void setNormalization(const Normalization mode) noexcept
         {
             m_normalization = mode;
+            compute();
         }
 
         //! Gets the normalization conversion.
@@ -221,48 +300,88 @@ namespace hoa
 
 
         //! This method performs the numbering and the normalization.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. Each output is an input weighted by a factor.
          @param     inputs   The inputs array.
          @param     outputs  The outputs array.
          */
         void process(T const* inputs, T* outputs) noexcept
         {
-            T const* ins = inputs;
-            if(m_numbering == fromFurseMalham)
+            const ulong size = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            T* vector = (inputs == outputs) ? m_vector : outputs;
+            for(ulong i = 0; i < size; i++)
             {
-                numberFromFurseMalham(inputs, outputs);
-                ins = outputs;
+                vector[i] = inputs[m_indices[i]] * m_factors[i];
             }
-            else if(m_numbering == fromSID)
+            if(vector != outputs)
             {
-                numberFromSID(inputs, outputs);
-                ins = outputs;
+                Signal<T>::copy(size, vector, outputs);
             }
-            switch(m_normalization)
+        }
+
+        //! This method performs the numbering and the normalization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the spherical harmonics and the minimum size must be the number of harmonics. Each output vector is an input vector scaled by a factor. For in-place processing with a renumbering, the vectors are processed by parts through a temporary buffer.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            bool inplace = false;
+            for(ulong i = 0; i < size && !inplace; i++)
             {
-                case fromMaxN:
-                    outputs[0] = ins[0] * T(sqrt(2.));
-                    Signal<T>::copy(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() - 1, ins+1, outputs+1);
-                    ins = outputs;
-                    break;
-                case toMaxN:
-                    outputs[0] = ins[0] / T(sqrt(2.));
-                    Signal<T>::copy(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() - 1, ins+1, outputs+1);
-                    ins = outputs;
-                    break;
-                default:
-                    break;
+                inplace = (m_indices[i] != i) && (inputs[i] == outputs[i]);
             }
-            if(m_numbering == toFurseMalham)
+            if(!inplace)
             {
-                numberToFurseMalham(ins, outputs);
+                for(ulong i = 0; i < size; i++)
+                {
+                    Signal<T>::scale(frames, m_factors[i], inputs[m_indices[i]], outputs[i]);
+                }
+                return;
             }
-            else if(m_numbering == toSID)
+            for(ulong i = 0; i < frames; i += m_chunk)
             {
-                numberToSID(ins, outputs);
+                const ulong chunk = min(m_chunk, frames - i);
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::scale(chunk, m_factors[j], inputs[m_indices[j]] + i, m_vector + j * m_chunk);
+                }
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::copy(chunk, m_vector + j * m_chunk, outputs[j] + i);
+                }
             }
         }
 
+        //! This method performs the numbering and the normalization by remapping the vectors.
+        /**	You should use this method for vector by vector processing when the vectors don't need to be copied. The outputs array receives the pointers of the input vectors in the output numbering, so a renumbering doesn't copy any sample. Only the vectors whose normalization changes are scaled, in place in the inputs array. The vectors that are neither moved nor scaled can be retrieved with isUnchanged().
+         @param     inputs   The input vectors.
+         @param     outputs  The array of the output vectors pointers.
+         @param     frames   The number of samples of the vectors.
+         */
+        void remap(T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                outputs[i] = inputs[m_indices[i]];
+                if(m_factors[i] != T(1.))
+                {
+                    Signal<T>::scale(frames, m_factors[i], outputs[i]);
+                }
+            }
+        }
+
+        //! Checks if an harmonic is unchanged by the conversion.
+        /**	An harmonic is unchanged if the output takes the input at the same index without any scaling, the host doesn't need to copy its vector.
+         @param     index	The index of the harmonic.
+         @return    True if the harmonic is unchanged.
+         */
+        inline bool isUnchanged(const ulong index) const noexcept
+        {
+            return m_indices[index] == index && m_factors[index] == T(1.);
+        }
+
         //! This method number the channels from Furse-Malham to ACN.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          @param     inputs   The inputs array.
@@ -423,6 +542,8 @@ namespace hoa
             }
         }
     };
+
+    template <typename T> const ulong Exchanger<Hoa2d, T>::m_chunk;
     
     
     
@@ -455,21 +576,101 @@ namespace hoa
         };
 
     private:
-
+        static const ulong m_chunk = 64ul;
         Numbering       m_numbering;
         Normalization   m_normalization;
+        ulong*          m_indices;
+        T*              m_factors;
         T*              m_harmonics;
+        T*              m_vector;
+
+        //! Get the index of an harmonic in the Furse-Malham numbering.
+        /** The Furse-Malham numbering is only defined up to the order 3, the harmonics of higher degrees keep their ACN index.
+         @param     index	The index of the harmonic in the ACN numbering.
+         @return    The index of the harmonic in the Furse-Malham numbering.
+         */
+        static inline ulong getFurseMalhamIndex(const ulong index) noexcept
+        {
+            static const ulong indices[16] = {0, 2, 3, 1, 8, 6, 4, 5, 7, 15, 13, 11, 9, 10, 12, 14};
+            return (index < 16ul) ? indices[index] : index;
+        }
+
+        //! Get the index of an harmonic in the SID numbering.
+        /** Get the index of an harmonic in the SID numbering.
+         @param     index	The index of the harmonic in the ACN numbering.
+         @return    The index of the harmonic in the SID numbering.
+         */
+        static inline ulong getSIDIndex(const ulong index) noexcept
+        {
+            const ulong degree  = Harmonic<Hoa3d, T>::getDegree(index);
+            const ulong offset  = index - degree * degree;
+            return degree * degree + ((offset % 2ul) ? offset / 2ul : 2ul * degree - offset / 2ul);
+        }
+
+        //! Get the factor of the MaxN normalization of an harmonic relative to the N3D normalization.
+        /** The MaxN normalization is only defined up to the order 3, the harmonics of higher degrees have a factor of 1.
+         @param     index	The index of the harmonic in the ACN numbering.
+         @return    The factor of the MaxN normalization.
+         */
+        static inline double getMaxNFactor(const ulong index) noexcept
+        {
+            static const double factors[16] =
+            {
+                sqrt(2.),
+                sqrt(3.), sqrt(3.), sqrt(3.),
+                sqrt(15.) / 2., sqrt(15.) / 2., sqrt(5.), sqrt(15.) / 2., sqrt(15.) / 2.,
+                sqrt(35. / 8.), sqrt(35.) / 3., sqrt(224. / 45), sqrt(7.), sqrt(224. / 45), sqrt(35.) / 3., sqrt(35. / 8.)
+            };
+            return (index < 16ul) ? factors[index] : 1.;
+        }
+
+        //! Compute the indices and the factors of the conversion.
+        /** The numbering and the normalization conversions are merged into a single gathering, each output takes an input weighted by a factor.
+         */
+        void compute() noexcept
+        {
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const ulong input   = (m_numbering == fromFurseMalham) ? getFurseMalhamIndex(i) : ((m_numbering == fromSID) ? getSIDIndex(i) : i);
+                const ulong output  = (m_numbering == toFurseMalham) ? getFurseMalhamIndex(i) : ((m_numbering == toSID) ? getSIDIndex(i) : i);
+                const double n3d    = sqrt(2. * double(Processor<Hoa3d, T>::Harmonics::getHarmonicDegree(i)) + 1.);
+                double factor = 1.;
+                switch(m_normalization)
+                {
+                    case fromN3D:
+                        factor = n3d;
+                        break;
+                    case toN3D:
+                        factor = 1. / n3d;
+                        break;
+                    case fromMaxN:
+                        factor = getMaxNFactor(i) * n3d;
+                        break;
+                    case toMaxN:
+                        factor = 1. / (getMaxNFactor(i) * n3d);
+                        break;
+                    default:
+                        break;
+                }
+                m_indices[output] = input;
+                m_factors[output] = T(factor);
+            }
+        }
     public:
 
         //! The exchanger constructor.
-        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1 and should be 3 at maximum.
+        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1. The Furse-Malham numbering and the MaxN normalization are only defined up to the order 3, the harmonics of higher degrees keep their ACN index and their N3D factor.
          @param     order	The order.
          */
         inline Exchanger(const ulong order) noexcept : Processor<Hoa3d, T>::Harmonics(order),
         m_numbering(ACN),
         m_normalization(SN3D)
         {
+            m_indices   = new ulong[Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics()];
+            m_factors   = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
             m_harmonics = Signal<T>::alloc(order*2+1);
+            m_vector    = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics() * m_chunk);
+            compute();
         }
 
         //! The exchanger destructor.
@@ -477,7 +678,10 @@ namespace hoa
          */
         inline ~Exchanger() noexcept
         {
+            delete [] m_indices;
+            Signal<T>::free(m_factors);
             Signal<T>::free(m_harmonics);
+            Signal<T>::free(m_vector);
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -487,6 +691,7 @@ namespace hoa
         {
             m_numbering = fromFurseMalham;
             m_normalization = fromMaxN;
+            compute();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -496,6 +701,7 @@ namespace hoa
         {
             m_numbering = toFurseMalham;
             m_normalization = toMaxN;
+            compute();
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -505,6 +711,7 @@ namespace hoa
         {
             m_numbering = fromSID;
             m_normalization = fromN3D;
+            compute();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -514,6 +721,7 @@ namespace hoa
         {
             m_numbering = toSID;
             m_normalization = toN3D;
+            compute();
         }
 
         //! Sets the numbering conversion.
@@ -523,6 +731,7 @@ namespace hoa
         inline void setNumbering(const Numbering mode) noexcept
         {
             m_numbering = mode;
+            compute();
         }
 
         //! Gets the numbering conversion.
@@ -541,6 +750,7 @@ namespace hoa
         inline void setNormalization(const Normalization mode) noexcept
         {
             m_normalization = mode;
+            compute();
         }
 
         //! Gets the normalization conversion.
@@ -553,54 +763,88 @@ namespace hoa
         }
 
         //! This method performs the numbering and the normalization.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. Each output is an input weighted by a factor.
          @param     inputs   The inputs array.
          @param     outputs  The outputs array.
          */
         void process(T const* inputs, T* outputs) noexcept
         {
-            T const* ins = inputs;
-            if(m_numbering == fromFurseMalham)
+            const ulong size = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            T* vector = (inputs == outputs) ? m_vector : outputs;
+            for(ulong i = 0; i < size; i++)
             {
-                numberFromFurseMalham(inputs, outputs);
-                ins = outputs;
+                vector[i] = inputs[m_indices[i]] * m_factors[i];
             }
-            else if(m_numbering == fromSID)
+            if(vector != outputs)
             {
-                numberFromSID(inputs, outputs);
-                ins = outputs;
+                Signal<T>::copy(size, vector, outputs);
             }
-            switch(m_normalization)
+        }
+
+        //! This method performs the numbering and the normalization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the spherical harmonics and the minimum size must be the number of harmonics. Each output vector is an input vector scaled by a factor. For in-place processing with a renumbering, the vectors are processed by parts through a temporary buffer.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            bool inplace = false;
+            for(ulong i = 0; i < size && !inplace; i++)
+            {
+                inplace = (m_indices[i] != i) && (inputs[i] == outputs[i]);
+            }
+            if(!inplace)
             {
-                case fromMaxN:
-                    normalizeFromMaxN(ins, outputs);
-                    ins = outputs;
-                    break;
-                case fromN3D:
-                    normalizeFromN3D(ins, outputs);
-                    ins = outputs;
-                    break;
-                case toMaxN:
-                    normalizeToMaxN(ins, outputs);
-                    ins = outputs;
-                    break;
-                case toN3D:
-                    normalizeToN3D(ins, outputs);
-                    ins = outputs;
-                    break;
-                default:
-                    break;
+                for(ulong i = 0; i < size; i++)
+                {
+                    Signal<T>::scale(frames, m_factors[i], inputs[m_indices[i]], outputs[i]);
+                }
+                return;
             }
-            if(m_numbering == toFurseMalham)
+            for(ulong i = 0; i < frames; i += m_chunk)
             {
-                numberToFurseMalham(ins, outputs);
+                const ulong chunk = min(m_chunk, frames - i);
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::scale(chunk, m_factors[j], inputs[m_indices[j]] + i, m_vector + j * m_chunk);
+                }
+                for(ulong j = 0; j < size; j++)
+                {
+                    Signal<T>::copy(chunk, m_vector + j * m_chunk, outputs[j] + i);
+                }
             }
-            else if(m_numbering == toSID)
+        }
+
+        //! This method performs the numbering and the normalization by remapping the vectors.
+        /**	You should use this method for vector by vector processing when the vectors don't need to be copied. The outputs array receives the pointers of the input vectors in the output numbering, so a renumbering doesn't copy any sample. Only the vectors whose normalization changes are scaled, in place in the inputs array. The vectors that are neither moved nor scaled can be retrieved with isUnchanged().
+         @param     inputs   The input vectors.
+         @param     outputs  The array of the output vectors pointers.
+         @param     frames   The number of samples of the vectors.
+         */
+        void remap(T** inputs, T** outputs, const ulong frames) noexcept
+        {
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
             {
-                numberToSID(ins, outputs);
+                outputs[i] = inputs[m_indices[i]];
+                if(m_factors[i] != T(1.))
+                {
+                    Signal<T>::scale(frames, m_factors[i], outputs[i]);
+                }
             }
         }
 
+        //! Checks if an harmonic is unchanged by the conversion.
+        /**	An harmonic is unchanged if the output takes the input at the same index without any scaling, the host doesn't need to copy its vector.
+         @param     index	The index of the harmonic.
+         @return    True if the harmonic is unchanged.
+         */
+        inline bool isUnchanged(const ulong index) const noexcept
+        {
+            return m_indices[index] == index && m_factors[index] == T(1.);
+        }
+
         //! This method number the channels from Furse-Malham to ACN.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          @param     inputs   The inputs array.
@@ -947,6 +1191,8 @@ namespace hoa
         }
     };
 
+    template <typename T> const ulong Exchanger<Hoa3d, T>::m_chunk;
+
 //! @endcond
 }
 
@@ -0,0 +1,192 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_FFT_LIGHT
+#define DEF_HOA_FFT_LIGHT
+
+#include "Signal.hpp"
+
+namespace hoa
+{
+    //! The fft class performs the discrete fourier transform of real signals.
+    /** The fft computes the forward and the inverse transforms of real signals with a radix-2 algorithm. The size must be a power of 2. The spectrum of a signal of size \f$N\f$ contains the \f$\frac{N}{2} + 1\f$ first bins as interleaved real and imaginary parts, so its size is \f$N + 2\f$. The transforms are not scaled, a forward transform followed by an inverse transform multiplies the signal by \f$N\f$.
+     */
+    template <typename T> class Fft
+    {
+    private:
+        const ulong m_size;
+        const ulong m_half;
+        ulong*      m_reverse;
+        T*          m_twiddle;
+
+        //! Performs the complex transform in place.
+        /** The complex transform of size \f$\frac{N}{2}\f$ uses the even twiddle factors of the real transform of size \f$N\f$.
+         @param vector  The interleaved complex vector.
+         @param sign    1 for the forward transform, -1 for the inverse transform.
+         */
+        inline void complex(T* vector, const T sign) const noexcept
+        {
+            for(ulong i = 0; i < m_half; i++)
+            {
+                const ulong j = m_reverse[i];
+                if(i < j)
+                {
+                    std::swap(vector[i*2], vector[j*2]);
+                    std::swap(vector[i*2+1], vector[j*2+1]);
+                }
+            }
+            for(ulong len = 2; len <= m_half; len <<= 1)
+            {
+                const ulong half = len >> 1;
+                const ulong step = (m_half / len) * 2;
+                for(ulong i = 0; i < m_half; i += len)
+                {
+                    T* a = vector + i * 2;
+                    T* b = vector + (i + half) * 2;
+                    for(ulong j = 0; j < half; j++)
+                    {
+                        const T wr = m_twiddle[j*step*2];
+                        const T wi = m_twiddle[j*step*2+1] * sign;
+                        const T vr = b[j*2] * wr - b[j*2+1] * wi;
+                        const T vi = b[j*2] * wi + b[j*2+1] * wr;
+                        b[j*2]   = a[j*2] - vr;
+                        b[j*2+1] = a[j*2+1] - vi;
+                        a[j*2]   += vr;
+                        a[j*2+1] += vi;
+                    }
+                }
+            }
+        }
+
+    public:
+
+        //! The fft constructor.
+        /** The fft constructor allocates and initializes the tables depending on the size of the transform.
+         @param size The size of the transform, must be a power of 2 and at least 2.
+         */
+        Fft(const ulong size) noexcept :
+        m_size(size),
+        m_half(size >> 1)
+        {
+            m_reverse = new ulong[m_half];
+            ulong bits = 0;
+            while((1ul << bits) < m_half)
+            {
+                bits++;
+            }
+            for(ulong i = 0; i < m_half; i++)
+            {
+                ulong r = 0;
+                for(ulong j = 0; j < bits; j++)
+                {
+                    r |= ((i >> j) & 1ul) << (bits - 1ul - j);
+                }
+                m_reverse[i] = r;
+            }
+            m_twiddle = Signal<T>::alloc(m_size);
+            for(ulong i = 0; i < m_half; i++)
+            {
+                m_twiddle[i*2]   = T(cos(HOA_2PI * double(i) / double(m_size)));
+                m_twiddle[i*2+1] = T(-sin(HOA_2PI * double(i) / double(m_size)));
+            }
+        }
+
+        //! The fft destructor.
+        /** The fft destructor free the memory.
+         */
+        ~Fft() noexcept
+        {
+            delete [] m_reverse;
+            Signal<T>::free(m_twiddle);
+        }
+
+        //! Retrieve the size of the transform.
+        /** Retrieve the size of the transform.
+         @return The size of the transform.
+         */
+        inline ulong getSize() const noexcept
+        {
+            return m_size;
+        }
+
+        //! Retrieve the size of the spectrum.
+        /** Retrieve the size of the spectrum, the number of real values used to store the \f$\frac{N}{2} + 1\f$ complex bins.
+         @return The size of the spectrum.
+         */
+        inline ulong getSpectrumSize() const noexcept
+        {
+            return m_size + 2;
+        }
+
+        //! Performs the forward transform.
+        /** Performs the forward transform of a real signal. The input and the output can't be the same array.
+         @param input   The real signal of size \f$N\f$.
+         @param output  The spectrum of size \f$N + 2\f$.
+         */
+        inline void forward(const T* input, T* output) const noexcept
+        {
+            Signal<T>::copy(m_size, input, output);
+            complex(output, 1.);
+            const T zr = output[0];
+            const T zi = output[1];
+            output[0]        = zr + zi;
+            output[1]        = 0.;
+            output[m_size]   = zr - zi;
+            output[m_size+1] = 0.;
+            for(ulong k = 1; k <= (m_half >> 1); k++)
+            {
+                T* a = output + k * 2;
+                T* b = output + (m_half - k) * 2;
+                const T er = (a[0] + b[0]) * T(0.5);
+                const T ei = (a[1] - b[1]) * T(0.5);
+                const T or_ = (a[1] + b[1]) * T(0.5);
+                const T oi = (b[0] - a[0]) * T(0.5);
+                const T wr = m_twiddle[k*2];
+                const T wi = m_twiddle[k*2+1];
+                const T tr = wr * or_ - wi * oi;
+                const T ti = wr * oi + wi * or_;
+                a[0] = er + tr;
+                a[1] = ei + ti;
+                b[0] = er - tr;
+                b[1] = ti - ei;
+            }
+        }
+
+        //! Performs the inverse transform.
+        /** Performs the inverse transform of a spectrum. The result is not scaled and the input is used as a temporary buffer.
+         @param input   The spectrum of size \f$N + 2\f$.
+         @param output  The real signal of size \f$N\f$.
+         */
+        inline void inverse(T* input, T* output) const noexcept
+        {
+            const T xr0 = input[0];
+            const T xrn = input[m_size];
+            input[0] = xr0 + xrn;
+            input[1] = xr0 - xrn;
+            for(ulong k = 1; k <= (m_half >> 1); k++)
+            {
+                T* a = input + k * 2;
+                T* b = input + (m_half - k) * 2;
+                const T er = a[0] + b[0];
+                const T ei = a[1] - b[1];
+                const T dr = a[0] - b[0];
+                const T di = a[1] + b[1];
+                const T wr = m_twiddle[k*2];
+                const T wi = -m_twiddle[k*2+1];
+                const T or_ = wr * dr - wi * di;
+                const T oi = wr * di + wi * dr;
+                a[0] = er - oi;
+                a[1] = ei + or_;
+                b[0] = er + oi;
+                b[1] = or_ - ei;
+            }
+            complex(input, -1.);
+            Signal<T>::copy(m_size, input, output);
+        }
+    };
+}
+
+#endif
@@ -259,6 +259,61 @@ namespace hoa
     template <typename T> class Harmonic<Hoa3d, T>
     {
     private:
+        static const ulong m_maximum = 63ul;
+
+        //! The tables of the harmonics.
+        /** The tables store the degree, the order, the semi-normalization and the normalization of the harmonics up to the maximum order in ACN ordering. They are built once at the first use and are shared by all the processors.
+         */
+        struct Tables
+        {
+            ulong   degrees[(m_maximum + 1) * (m_maximum + 1)];
+            long    orders[(m_maximum + 1) * (m_maximum + 1)];
+            T       semi_normalizations[(m_maximum + 1) * (m_maximum + 1)];
+            T       normalizations[(m_maximum + 1) * (m_maximum + 1)];
+
+            Tables() noexcept
+            {
+                for(ulong l = 0; l <= m_maximum; l++)
+                {
+                    long double ratio = 1.;
+                    for(ulong m = 0; m <= l; m++)
+                    {
+                        if(m)
+                        {
+                            ratio /= (long double)((l + m) * (l - m + 1));
+                        }
+                        const T semi = T(std::sqrt(ratio * (m ? 2. : 1.) / (4. * HOA_PI)));
+                        const T norm = T(semi * std::sqrt(2. * double(l) + 1.));
+                        for(long sign = -1; sign <= 1; sign += 2)
+                        {
+                            const ulong index = ulong(long(l * (l + 1)) + sign * long(m));
+                            degrees[index]              = l;
+                            orders[index]               = sign * long(m);
+                            semi_normalizations[index]  = semi;
+                            normalizations[index]       = norm;
+                        }
+                    }
+                }
+            }
+        };
+
+        static const Tables& tables() noexcept
+        {
+            static const Tables instance;
+            return instance;
+        }
+
+        //! The ratio of the factorials (l - |m|)! / (l + |m|)! computed as a product to avoid the overflow of the factorials.
+        static long double ratio(const ulong degree, const long order) noexcept
+        {
+            long double result = 1.;
+            for(ulong i = degree - ulong(abs(order)) + 1; i <= degree + ulong(abs(order)); i++)
+            {
+                result /= (long double)(i);
+            }
+            return result;
+        }
+
         ulong m_index;
     public:
 
@@ -295,7 +350,7 @@ namespace hoa
          */
         inline ulong getDegree() const noexcept
         {
-            return ulong(sqrt(float(m_index)));
+            return getDegree(m_index);
         }
 
         //! Get the order of the harmonic.
@@ -304,7 +359,7 @@ namespace hoa
          */
         inline long getOrder() const noexcept
         {
-            return long(m_index) - long(getDegree() * (getDegree() + 1));
+            return getOrder(m_index);
         }
 
         //! Get the name of the harmonic.
@@ -341,7 +396,11 @@ namespace hoa
          */
         static inline ulong getDegree(const ulong index) noexcept
         {
-            return ulong(sqrt(float(index)));
+            if(index < getNumberOfHarmonics(m_maximum))
+            {
+                return tables().degrees[index];
+            }
+            return ulong(sqrt(double(index)));
         }
 
         //! Get the order of an harmonic with an index.
@@ -351,7 +410,11 @@ namespace hoa
          */
         static inline long getOrder(const ulong index) noexcept
         {
-            return long(index) - (long(sqrt(float(index))) * (long(sqrt(float(index))) + 1));
+            if(index < getNumberOfHarmonics(m_maximum))
+            {
+                return tables().orders[index];
+            }
+            return long(index) - long(getDegree(index) * (getDegree(index) + 1));
         }
 
         //! Get the index of an harmonic with its degree and its order.
@@ -383,6 +446,10 @@ namespace hoa
          */
         static inline T getNormalization(const ulong degree, const long order) noexcept
         {
+            if(degree <= m_maximum)
+            {
+                return tables().normalizations[getIndex(degree, order)];
+            }
             return getSemiNormalization(degree, order) * sqrt(2. * double(degree) + 1.);
         }
 
@@ -394,13 +461,41 @@ namespace hoa
          */
         static inline T getSemiNormalization(const ulong degree, const long order) noexcept
         {
-            if(order == 0)
+            if(degree <= m_maximum)
             {
-                return T(sqrt(Math<T>::factorial(long(degree) - long(abs(order))) / Math<T>::factorial(long(order) + long(abs(order))))) * T(sqrt(T(1.) / T(4. * HOA_PI)));
+                return tables().semi_normalizations[getIndex(degree, order)];
             }
-            else
+            return T(std::sqrt(ratio(degree, order) * (order ? 2. : 1.) / (4. * HOA_PI)));
+        }
+
+        //! Get the semi-normalizations of the harmonics.
+        /** The method returns the semi-normalizations of the harmonics up to an order of decomposition in ACN ordering. Up to the order 63, the array is shared by all the processors, above it is allocated. The array must be released with releaseSemiNormalizations().
+         @param order   The order of decomposition.
+         @return        The semi-normalizations of the harmonics.
+         */
+        static inline const T* acquireSemiNormalizations(const ulong order) noexcept
+        {
+            if(order <= m_maximum)
+            {
+                return tables().semi_normalizations;
+            }
+            T* normalizations = Signal<T>::alloc(getNumberOfHarmonics(order));
+            for(ulong i = 0; i < getNumberOfHarmonics(order); i++)
+            {
+                normalizations[i] = getSemiNormalization(getDegree(i), getOrder(i));
+            }
+            return normalizations;
+        }
+
+        //! Release the semi-normalizations of the harmonics.
+        /** The method releases an array returned by acquireSemiNormalizations().
+         @param normalizations  The semi-normalizations of the harmonics.
+         */
+        static inline void releaseSemiNormalizations(const T* normalizations) noexcept
+        {
+            if(normalizations != tables().semi_normalizations)
             {
-                return T(sqrt(Math<T>::factorial(long(degree) - abs(order)) / Math<T>::factorial(long(degree) + abs(order))) * sqrt(T(2.) / T(4. * HOA_PI)));
+                Signal<T>::free(const_cast<T*>(normalizations));
             }
         }
     };
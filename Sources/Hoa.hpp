@@ -13,6 +13,7 @@
 #include "Optim.hpp"
 #include "Rotate.hpp"
 #include "Decoder.hpp"
+#include "Listeners.hpp"
 #include "Vector.hpp"
 #include "Meter.hpp"
 #include "Projector.hpp"
@@ -21,6 +22,7 @@
 #include "Wider.hpp"
 #include "Source.hpp"
 #include "Exchanger.hpp"
+#include "Chain.hpp"
 #include "Tools.hpp"
 
 #endif
@@ -8,8 +8,28 @@
 #ifndef DEF_HOA_HRIR_LIGHT
 #define DEF_HOA_HRIR_LIGHT
 
+#include "Encoder.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdint>
+#include <new>
+
+#ifdef _WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The compiled tables can be removed with HOA_NO_HRIR_TABLES when the
+// responses are only loaded from files, see HrirFile.
+#ifndef HOA_NO_HRIR_TABLES
 #include "HrirIrc1002C2D.hpp"
 #include "HrirIrc1002C3D.hpp"
+#endif
 
 namespace hoa
 {
@@ -25,6 +45,8 @@ namespace hoa
         virtual const float* getImpulse() noexcept = 0;
     };
 
+#ifndef HOA_NO_HRIR_TABLES
+
     template<> class Hrir <Hoa2d, float>
     {
     public:
@@ -261,6 +283,648 @@ namespace hoa
         }
     };
 
+#endif
+
+    //! The hrir file class maps the impulse responses of a binary file.
+    /** The hrir file class maps in memory a file that contains the matrices of the responses for the left and the right ears in the harmonics domain and gives them with the same interface as the hrir class, so loading a set of responses doesn't read or copy the matrices. The file starts with a header of 32 bytes that contains the characters "HOAH" followed by the version, the dimension (2 or 3), the size of a sample in bytes, the order of decomposition, the number of rows, the number of columns and the sample rate as 32 bits unsigned integers. The header is followed by the left matrix and the right matrix, row by row, with a row per sample of the responses and a column per harmonic. The files are written with the write method, for example by an offline tool that imports the responses of a SOFA file. The compiled responses of the IRCAM database are still included by default because the binaural processors constructed without a hrir file use them, they add about 1 MB of tables to every translation unit that includes the library. When all the responses are loaded from files, define HOA_NO_HRIR_TABLES before including the library to leave the tables out, the processors must then be constructed with a hrir file.
+     */
+    template <Dimension D, typename T> class HrirFile
+    {
+    private:
+        struct Header
+        {
+            char        magic[4];
+            uint32_t    version;
+            uint32_t    dimension;
+            uint32_t    precision;
+            uint32_t    order;
+            uint32_t    rows;
+            uint32_t    columns;
+            uint32_t    samplerate;
+        };
+
+        void*       m_data;
+        size_t      m_size;
+#ifdef _WINDOWS
+        HANDLE      m_file;
+        HANDLE      m_mapping;
+#endif
+        ulong       m_order;
+        ulong       m_rows;
+        ulong       m_columns;
+        ulong       m_samplerate;
+        const T*    m_left;
+        const T*    m_right;
+
+        HrirFile(const HrirFile& other) = delete;
+        HrirFile& operator=(const HrirFile& other) = delete;
+
+    public:
+
+        //! The hrir file constructor.
+        /** The hrir file constructor initializes an empty set of responses.
+         */
+        HrirFile() noexcept :
+        m_data(nullptr), m_size(0),
+#ifdef _WINDOWS
+        m_file(INVALID_HANDLE_VALUE), m_mapping(NULL),
+#endif
+        m_order(0), m_rows(0), m_columns(0), m_samplerate(0), m_left(nullptr), m_right(nullptr)
+        {
+            ;
+        }
+
+        //! The hrir file constructor.
+        /** The hrir file constructor maps a file, you should check that the file is open before using the matrices.
+         @param path The path of the file.
+         */
+        HrirFile(const string& path) noexcept : HrirFile()
+        {
+            open(path);
+        }
+
+        //! The hrir file destructor.
+        /** The hrir file destructor unmaps the file.
+         */
+        ~HrirFile() noexcept
+        {
+            close();
+        }
+
+        //! Maps a file.
+        /** Maps a file and checks that its header matches the dimension and the precision of the class and that its size matches the matrices. The previous file is unmapped.
+         @param path The path of the file.
+         @return true if the file is mapped, otherwise false.
+         */
+        bool open(const string& path) noexcept
+        {
+            close();
+#ifdef _WINDOWS
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if(m_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+            LARGE_INTEGER size;
+            if(!GetFileSizeEx(m_file, &size) || size.QuadPart < LONGLONG(sizeof(Header)))
+            {
+                close();
+                return false;
+            }
+            m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+            m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if(!m_data)
+            {
+                close();
+                return false;
+            }
+            m_size = size_t(size.QuadPart);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                return false;
+            }
+            struct stat st;
+            if(fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(Header)))
+            {
+                ::close(fd);
+                return false;
+            }
+            void* data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if(data == MAP_FAILED)
+            {
+                return false;
+            }
+            m_data = data;
+            m_size = size_t(st.st_size);
+#endif
+            const Header* header = static_cast<const Header *>(m_data);
+            const size_t msize = size_t(header->rows) * size_t(header->columns);
+            if(memcmp(header->magic, "HOAH", 4) || header->version != 1 ||
+               header->dimension != ((D == Hoa2d) ? 2u : 3u) || header->precision != sizeof(T) ||
+               !msize || m_size != sizeof(Header) + msize * 2 * sizeof(T))
+            {
+                close();
+                return false;
+            }
+            m_order         = header->order;
+            m_rows          = header->rows;
+            m_columns       = header->columns;
+            m_samplerate    = header->samplerate;
+            m_left          = reinterpret_cast<const T *>(static_cast<const char *>(m_data) + sizeof(Header));
+            m_right         = m_left + msize;
+            return true;
+        }
+
+        //! Unmaps the file.
+        /** Unmaps the file, the matrices are no more available.
+         */
+        void close() noexcept
+        {
+#ifdef _WINDOWS
+            if(m_data)
+            {
+                UnmapViewOfFile(m_data);
+            }
+            if(m_mapping)
+            {
+                CloseHandle(m_mapping);
+            }
+            if(m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+            }
+            m_file = INVALID_HANDLE_VALUE;
+            m_mapping = NULL;
+#else
+            if(m_data)
+            {
+                munmap(m_data, m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+            m_order = m_rows = m_columns = m_samplerate = 0;
+            m_left = m_right = nullptr;
+        }
+
+        //! Checks if a file is mapped.
+        /** Checks if a file is mapped.
+         @return true if a file is mapped, otherwise false.
+         */
+        inline bool isOpen() const noexcept
+        {
+            return m_data != nullptr;
+        }
+
+        //! Gets the order of decomposition used to compute the matrices.
+        /** Gets the order of decomposition used to compute the matrices.
+         @return The order of decomposition.
+         */
+        inline ulong getOrderOfDecomposition() const noexcept
+        {
+            return m_order;
+        }
+
+        //! Gets the number rows of the matrices (or the size of the responses used to compute the matrices).
+        /** Gets the number rows of the matrices (or the size of the responses used to compute the matrices).
+         @return The number rows of the matrices.
+         */
+        inline ulong getNumberOfRows() const noexcept
+        {
+            return m_rows;
+        }
+
+        //! Gets the number columns of the matrices (or the number of harmonics used to compute the matrices).
+        /** Gets the number columns of the matrices (or the number of harmonics used to compute the matrices).
+         @return The number columns of the matrices.
+         */
+        inline ulong getNumberOfColumns() const noexcept
+        {
+            return m_columns;
+        }
+
+        //! Gets the size of the matrices (rows * columns).
+        /** Gets the size of the matrices (rows * columns).
+         @return The size of the matrices.
+         */
+        inline ulong getMatricesSize() const noexcept
+        {
+            return m_rows * m_columns;
+        }
+
+        //! Gets the sample rate of the responses.
+        /** Gets the sample rate of the responses.
+         @return The sample rate of the responses.
+         */
+        inline ulong getSampleRate() const noexcept
+        {
+            return m_samplerate;
+        }
+
+        //! Get the HRIR matrix for the left ear.
+        /** Get the HRIR matrix for the left ear.
+         @return The HRIR matrix for the left ear.
+         */
+        inline const T* getLeftMatrix() const noexcept
+        {
+            return m_left;
+        }
+
+        //! Get the HRIR matrix for the right ear.
+        /** Get the HRIR matrix for the right ear.
+         @return The HRIR matrix for the right ear.
+         */
+        inline const T* getRightMatrix() const noexcept
+        {
+            return m_right;
+        }
+
+        //! Writes a file.
+        /** Writes the matrices of the left and the right ears in a file that can be mapped by the class.
+         @param path        The path of the file.
+         @param order       The order of decomposition.
+         @param rows        The number of rows of the matrices.
+         @param columns     The number of columns of the matrices.
+         @param samplerate  The sample rate of the responses.
+         @param left        The matrix of the left ear.
+         @param right       The matrix of the right ear.
+         @return true if the file is written, otherwise false.
+         */
+        static bool write(const string& path, const ulong order, const ulong rows, const ulong columns, const ulong samplerate, const T* left, const T* right) noexcept
+        {
+            FILE* file = fopen(path.c_str(), "wb");
+            if(!file)
+            {
+                return false;
+            }
+            Header header;
+            memcpy(header.magic, "HOAH", 4);
+            header.version      = 1;
+            header.dimension    = (D == Hoa2d) ? 2 : 3;
+            header.precision    = sizeof(T);
+            header.order        = uint32_t(order);
+            header.rows         = uint32_t(rows);
+            header.columns      = uint32_t(columns);
+            header.samplerate   = uint32_t(samplerate);
+            bool valid = fwrite(&header, sizeof(Header), 1, file) == 1;
+            valid = valid && fwrite(left, sizeof(T), rows * columns, file) == rows * columns;
+            valid = valid && fwrite(right, sizeof(T), rows * columns, file) == rows * columns;
+            valid = (fclose(file) == 0) && valid;
+            return valid;
+        }
+    };
+
+    //! The hrir generator class computes the matrices of the binaural decoders from a set of responses.
+    /** The hrir generator takes the left and right impulse responses measured on a set of directions and computes the matrices of the responses in the harmonics domain for any order of decomposition. The directions use the conventions of the encoders, the azimuth is counterclockwise with 0 at the front and the elevation goes from the bottom to the top, in 2d only the azimuth is used so the set should contain the responses of the horizontal plane. The matrices are the regularized least squares solution of the system that maps the harmonics of each direction, computed with the basic encoder, to the responses of the direction. The matrices can be cached in hrir files keyed by the name and the content of the set, the order, the crop size and the sample rate.
+     */
+    template <Dimension D, typename T> class HrirGenerator
+    {
+    private:
+        const string    m_name;
+        const ulong     m_number_of_directions;
+        const ulong     m_size;
+        const ulong     m_samplerate;
+        T*              m_azimuths;
+        T*              m_elevations;
+        T*              m_left;
+        T*              m_right;
+        T               m_regularization;
+
+        //! Sets the direction of a 2d encoder, the elevation is ignored.
+        static inline void position(typename Encoder<Hoa2d, T>::Basic& encoder, const T azimuth, const T) noexcept
+        {
+            encoder.setAzimuth(azimuth);
+        }
+
+        //! Sets the direction of a 3d encoder.
+        static inline void position(typename Encoder<Hoa3d, T>::Basic& encoder, const T azimuth, const T elevation) noexcept
+        {
+            encoder.setAzimuth(azimuth);
+            encoder.setElevation(elevation);
+        }
+
+        //! Resamples a response.
+        /** Resamples a response with a Blackman windowed sinc interpolation, the cutoff frequency is lowered when the sample rate is lowered to avoid aliasing.
+         @param size    The size of the output response.
+         @param ratio   The ratio of the output sample rate by the input sample rate.
+         @param input   The input response.
+         @param output  The output response.
+         */
+        inline void resample(const ulong size, const double ratio, const T* input, double* output) const noexcept
+        {
+            if(ratio == 1.)
+            {
+                for(ulong i = 0; i < size; i++)
+                {
+                    output[i] = i < m_size ? double(input[i]) : 0.;
+                }
+                return;
+            }
+            const double cutoff = min(ratio, 1.) * 0.95;
+            const double width  = 16. / cutoff;
+            for(ulong i = 0; i < size; i++)
+            {
+                const double center = double(i) / ratio;
+                const long first    = max(long(std::ceil(center - width)), 0l);
+                const long last     = min(long(std::floor(center + width)), long(m_size) - 1l);
+                double sum = 0.;
+                for(long j = first; j <= last; j++)
+                {
+                    const double x = center - double(j);
+                    const double w = 0.42 + 0.5 * cos(HOA_PI * x / width) + 0.08 * cos(HOA_2PI * x / width);
+                    const double k = (x == 0.) ? cutoff : sin(HOA_PI * cutoff * x) / (HOA_PI * x);
+                    sum += double(input[j]) * k * w;
+                }
+                output[i] = sum;
+            }
+        }
+
+        //! Solves a symmetric positive definite system in place with the Cholesky decomposition.
+        /** Solves the system \f$GX = B\f$, the matrix \f$G\f$ is replaced by its decomposition and \f$B\f$ by the solution.
+         @param size    The size of the matrix.
+         @param columns The number of columns of the right-hand side.
+         @param matrix  The matrix \f$G\f$.
+         @param rhs     The right-hand side \f$B\f$, row by row.
+         @return false if the matrix isn't positive definite.
+         */
+        static bool solve(const ulong size, const ulong columns, double* matrix, double* rhs) noexcept
+        {
+            for(ulong j = 0; j < size; j++)
+            {
+                double diag = matrix[j * size + j];
+                for(ulong k = 0; k < j; k++)
+                {
+                    diag -= matrix[j * size + k] * matrix[j * size + k];
+                }
+                if(diag <= 0.)
+                {
+                    return false;
+                }
+                diag = std::sqrt(diag);
+                matrix[j * size + j] = diag;
+                for(ulong i = j + 1; i < size; i++)
+                {
+                    double value = matrix[i * size + j];
+                    for(ulong k = 0; k < j; k++)
+                    {
+                        value -= matrix[i * size + k] * matrix[j * size + k];
+                    }
+                    matrix[i * size + j] = value / diag;
+                }
+            }
+            for(ulong i = 0; i < size; i++)
+            {
+                for(ulong k = 0; k < i; k++)
+                {
+                    for(ulong c = 0; c < columns; c++)
+                    {
+                        rhs[i * columns + c] -= matrix[i * size + k] * rhs[k * columns + c];
+                    }
+                }
+                for(ulong c = 0; c < columns; c++)
+                {
+                    rhs[i * columns + c] /= matrix[i * size + i];
+                }
+            }
+            for(ulong i = size; i; i--)
+            {
+                for(ulong k = i; k < size; k++)
+                {
+                    for(ulong c = 0; c < columns; c++)
+                    {
+                        rhs[(i - 1) * columns + c] -= matrix[k * size + (i - 1)] * rhs[k * columns + c];
+                    }
+                }
+                for(ulong c = 0; c < columns; c++)
+                {
+                    rhs[(i - 1) * columns + c] /= matrix[(i - 1) * size + (i - 1)];
+                }
+            }
+            return true;
+        }
+
+    public:
+
+        //! The hrir generator constructor.
+        /** The hrir generator constructor allocates the directions and the responses of the set.
+         @param name                The name of the set used to name the cached files.
+         @param numberOfDirections  The number of directions.
+         @param size                The size of the responses.
+         @param samplerate          The sample rate of the responses.
+         */
+        HrirGenerator(const string& name, const ulong numberOfDirections, const ulong size, const ulong samplerate) noexcept :
+        m_name(name),
+        m_number_of_directions(numberOfDirections),
+        m_size(size),
+        m_samplerate(samplerate),
+        m_regularization(1e-6)
+        {
+            m_azimuths      = Signal<T>::alloc(m_number_of_directions);
+            m_elevations    = Signal<T>::alloc(m_number_of_directions);
+            m_left          = Signal<T>::alloc(m_number_of_directions * m_size);
+            m_right         = Signal<T>::alloc(m_number_of_directions * m_size);
+        }
+
+        //! The hrir generator destructor.
+        /** The hrir generator destructor free the memory.
+         */
+        ~HrirGenerator() noexcept
+        {
+            Signal<T>::free(m_azimuths);
+            Signal<T>::free(m_elevations);
+            Signal<T>::free(m_left);
+            Signal<T>::free(m_right);
+        }
+
+        //! Sets the direction of a pair of responses.
+        /** Sets the direction of a pair of responses.
+         @param index       The index of the direction.
+         @param azimuth     The azimuth in radian.
+         @param elevation   The elevation in radian, ignored in 2d.
+         */
+        inline void setDirection(const ulong index, const T azimuth, const T elevation = 0.) noexcept
+        {
+            m_azimuths[index]   = azimuth;
+            m_elevations[index] = elevation;
+        }
+
+        //! Sets the responses of a direction.
+        /** Copies the responses of the left and the right ears of a direction.
+         @param index   The index of the direction.
+         @param left    The response of the left ear.
+         @param right   The response of the right ear.
+         */
+        inline void setResponses(const ulong index, const T* left, const T* right) noexcept
+        {
+            Signal<T>::copy(m_size, left, m_left + index * m_size);
+            Signal<T>::copy(m_size, right, m_right + index * m_size);
+        }
+
+        //! Sets the regularization of the least squares.
+        /** Sets the regularization of the least squares relatively to the mean energy of the harmonics, higher values attenuate the harmonics that are badly sampled by the directions of the set. The default value is \f$10^{-6}\f$.
+         @param value The regularization.
+         */
+        inline void setRegularization(const T value) noexcept
+        {
+            m_regularization = max(value, T(0.));
+        }
+
+        //! Gets the number of rows of the matrices.
+        /** Gets the number of rows of the matrices, the size of the responses after the resampling and the crop.
+         @param crop        The crop size in samples at the output sample rate, 0 means no crop.
+         @param samplerate  The output sample rate.
+         @return The number of rows of the matrices.
+         */
+        inline ulong getNumberOfRows(const ulong crop, const ulong samplerate) const noexcept
+        {
+            const ulong size = ulong(std::ceil(double(m_size) * double(samplerate) / double(m_samplerate)));
+            return (crop && crop < size) ? crop : size;
+        }
+
+        //! Generates the matrices.
+        /** Resamples and crops the responses then computes the matrices of the left and the right ears, row by row with a row per sample and a column per harmonic.
+         @param order       The order of decomposition.
+         @param crop        The crop size in samples at the output sample rate, 0 means no crop.
+         @param samplerate  The output sample rate.
+         @param left        The matrix of the left ear, its size must be the number of rows by the number of harmonics.
+         @param right       The matrix of the right ear, its size must be the number of rows by the number of harmonics.
+         @return false if the directions don't allow to solve the system or if the memory can't be allocated.
+         */
+        bool generate(const ulong order, const ulong crop, const ulong samplerate, T* left, T* right) const noexcept
+        {
+            try
+            {
+                const ulong nh      = Harmonic<D, T>::getNumberOfHarmonics(order);
+                const ulong np      = m_number_of_directions;
+                const ulong rows    = getNumberOfRows(crop, samplerate);
+                const double ratio  = double(samplerate) / double(m_samplerate);
+                vector<double> harmonics(np * nh), gram(nh * nh), rhs(nh * rows * 2), response(rows);
+                vector<T> coeffs(nh);
+                typename Encoder<D, T>::Basic encoder(order);
+                for(ulong p = 0; p < np; p++)
+                {
+                    const T factor = 1.;
+                    position(encoder, m_azimuths[p], m_elevations[p]);
+                    encoder.process(&factor, coeffs.data());
+                    for(ulong h = 0; h < nh; h++)
+                    {
+                        harmonics[p * nh + h] = double(coeffs[h]);
+                    }
+                }
+                double trace = 0.;
+                for(ulong i = 0; i < nh; i++)
+                {
+                    for(ulong j = 0; j < nh; j++)
+                    {
+                        double sum = 0.;
+                        for(ulong p = 0; p < np; p++)
+                        {
+                            sum += harmonics[p * nh + i] * harmonics[p * nh + j];
+                        }
+                        gram[i * nh + j] = sum;
+                    }
+                    trace += gram[i * nh + i];
+                }
+                for(ulong i = 0; i < nh; i++)
+                {
+                    gram[i * nh + i] += double(m_regularization) * trace / double(nh);
+                }
+                for(ulong p = 0; p < np; p++)
+                {
+                    for(ulong e = 0; e < 2; e++)
+                    {
+                        resample(rows, ratio, (e ? m_right : m_left) + p * m_size, response.data());
+                        for(ulong h = 0; h < nh; h++)
+                        {
+                            const double coeff = harmonics[p * nh + h];
+                            double* out = rhs.data() + h * rows * 2 + e * rows;
+                            for(ulong n = 0; n < rows; n++)
+                            {
+                                out[n] += coeff * response[n];
+                            }
+                        }
+                    }
+                }
+                if(!solve(nh, rows * 2, gram.data(), rhs.data()))
+                {
+                    return false;
+                }
+                for(ulong n = 0; n < rows; n++)
+                {
+                    for(ulong h = 0; h < nh; h++)
+                    {
+                        left[n * nh + h]    = T(rhs[h * rows * 2 + n]);
+                        right[n * nh + h]   = T(rhs[h * rows * 2 + rows + n]);
+                    }
+                }
+                return true;
+            }
+            catch(const std::bad_alloc&)
+            {
+                return false;
+            }
+        }
+
+        //! Gets the path of a cached file.
+        /** Gets the path of the file that caches the matrices of the set for an order, a crop size and a sample rate. The name of the file contains the name of the set and a hash of its directions, its responses and the regularization, so a modified set doesn't use the files of the previous one.
+         @param directory   The directory of the cache.
+         @param order       The order of decomposition.
+         @param crop        The crop size in samples at the output sample rate, 0 means no crop.
+         @param samplerate  The output sample rate.
+         @return The path of the file.
+         */
+        string getCachePath(const string& directory, const ulong order, const ulong crop, const ulong samplerate) const
+        {
+            uint64_t hash = 14695981039346656037ull;
+            const T* arrays[5] = {m_azimuths, m_elevations, m_left, m_right, &m_regularization};
+            const ulong sizes[5] = {m_number_of_directions, m_number_of_directions, m_number_of_directions * m_size, m_number_of_directions * m_size, 1ul};
+            for(ulong i = 0; i < 5; i++)
+            {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char *>(arrays[i]);
+                for(size_t j = 0; j < sizes[i] * sizeof(T); j++)
+                {
+                    hash = (hash ^ bytes[j]) * 1099511628211ull;
+                }
+            }
+            char key[17];
+            snprintf(key, sizeof(key), "%016llx", (unsigned long long)hash);
+            string name;
+            for(ulong i = 0; i < m_name.size(); i++)
+            {
+                const char c = m_name[i];
+                name += (isalnum((unsigned char)c) || c == '-') ? c : '_';
+            }
+            string path = directory;
+            if(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\')
+            {
+                path += '/';
+            }
+            return path + name + "_" + key + ((D == Hoa2d) ? "_2d" : "_3d") + ((sizeof(T) == sizeof(float)) ? "_float" : "_double")
+            + "_o" + to_string(order) + "_c" + to_string(getNumberOfRows(crop, samplerate)) + "_r" + to_string(samplerate) + ".hoah";
+        }
+
+        //! Opens the matrices from the cache or generates them.
+        /** Maps the cached file of the matrices if it exists, otherwise generates the matrices, writes them in the cache and maps the file.
+         @param file        The hrir file that maps the matrices.
+         @param directory   The directory of the cache.
+         @param order       The order of decomposition.
+         @param crop        The crop size in samples at the output sample rate, 0 means no crop.
+         @param samplerate  The output sample rate.
+         @return true if the file is mapped, otherwise false, for example if the memory can't be allocated.
+         */
+        bool load(HrirFile<D, T>& file, const string& directory, const ulong order, const ulong crop, const ulong samplerate) const noexcept
+        {
+            try
+            {
+                const string path = getCachePath(directory, order, crop, samplerate);
+                if(file.open(path))
+                {
+                    return true;
+                }
+                const ulong rows    = getNumberOfRows(crop, samplerate);
+                const ulong nh      = Harmonic<D, T>::getNumberOfHarmonics(order);
+                vector<T> left(rows * nh), right(rows * nh);
+                if(!generate(order, crop, samplerate, left.data(), right.data()))
+                {
+                    return false;
+                }
+                const string temp = path + ".tmp";
+                if(!HrirFile<D, T>::write(temp, order, rows, nh, samplerate, left.data(), right.data()) || std::rename(temp.c_str(), path.c_str()) != 0)
+                {
+                    std::remove(temp.c_str());
+                    return false;
+                }
+                return file.open(path);
+            }
+            catch(const std::bad_alloc&)
+            {
+                return false;
+            }
+        }
+    };
 }
 
 #endif
@@ -0,0 +1,441 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_LISTENERS_LIGHT
+#define DEF_HOA_LISTENERS_LIGHT
+
+#include "Rotate.hpp"
+#include "Hrir.hpp"
+#include "Fft.hpp"
+
+namespace hoa
+{
+    //! The listeners class decodes a sound field in the harmonics domain for several listeners with headphones.
+    /** The listeners class renders the same sound field for several listeners, each one with its own rotation of the sound field, for example to follow the head of the listener. The harmonics are transformed once per vector and stored in a frequency-domain delay line, as for the convolver, then the harmonics are convolved with the responses of the harmonics of the same degree and the results are shared by all the listeners. Since a rotation only mixes the harmonics of the same degree, the spectrum of an ear of a listener is the sum of these products weighted by the coefficients of the rotation, so each listener only costs the weighted sum and two inverse transforms. The rotations are applied to the whole responses, a change of rotation takes effect at the next vector.
+     */
+    template <Dimension D, typename T> class Listeners : public Processor<D, T>::Harmonics
+    {
+    private:
+        const ulong     m_number_of_listeners;
+        const T*        m_left;
+        const T*        m_right;
+        const ulong     m_rows;
+        const ulong     m_columns;
+        const ulong     m_number_of_inputs;
+        ulong           m_number_of_pairs;
+        ulong*          m_pairs;
+        T*              m_rotations;
+        T*              m_vector;
+        ulong           m_crop_size;
+        ulong           m_vector_size;
+        ulong           m_fft_size;
+        ulong           m_spectrum_size;
+        ulong           m_number_of_partitions;
+        ulong           m_current;
+        Fft<T>*         m_fft;
+        T*              m_frames;
+        T*              m_spectra;
+        T*              m_responses;
+        T*              m_products;
+        T*              m_accumulator;
+        T*              m_buffer;
+        T*              m_fifo;
+        ulong           m_count;
+        bool            m_streaming;
+        vector<const T*> m_fifo_inputs;
+        vector<T*>      m_fifo_outputs;
+
+        //! Initializes the pairs of harmonics and the rotations.
+        /** The pairs contain the harmonics of the same degree and the rotations are initialized to the identity.
+         */
+        void initialize() noexcept
+        {
+            m_number_of_pairs = 0;
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                for(ulong j = 0; j < m_number_of_inputs; j++)
+                {
+                    if(Processor<D, T>::Harmonics::getHarmonicDegree(i) == Processor<D, T>::Harmonics::getHarmonicDegree(j))
+                    {
+                        m_number_of_pairs++;
+                    }
+                }
+            }
+            m_pairs     = new ulong[m_number_of_pairs * 2];
+            m_rotations = Signal<T>::alloc(m_number_of_listeners * m_number_of_pairs);
+            m_vector    = Signal<T>::alloc(Processor<D, T>::Harmonics::getNumberOfHarmonics() * 2);
+            ulong index = 0;
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                for(ulong j = 0; j < m_number_of_inputs; j++)
+                {
+                    if(Processor<D, T>::Harmonics::getHarmonicDegree(i) == Processor<D, T>::Harmonics::getHarmonicDegree(j))
+                    {
+                        m_pairs[index * 2]      = i;
+                        m_pairs[index * 2 + 1]  = j;
+                        for(ulong k = 0; k < m_number_of_listeners; k++)
+                        {
+                            m_rotations[k * m_number_of_pairs + index] = (i == j) ? T(1.) : T(0.);
+                        }
+                        index++;
+                    }
+                }
+            }
+            m_crop_size = m_rows;
+        }
+
+        void clear() noexcept
+        {
+            if(m_fft)
+            {
+                delete m_fft;
+                m_fft = nullptr;
+            }
+            m_frames        = Signal<T>::free(m_frames);
+            m_spectra       = Signal<T>::free(m_spectra);
+            m_responses     = Signal<T>::free(m_responses);
+            m_products      = Signal<T>::free(m_products);
+            m_accumulator   = Signal<T>::free(m_accumulator);
+            m_buffer        = Signal<T>::free(m_buffer);
+            m_fifo          = Signal<T>::free(m_fifo);
+            m_fifo_inputs.clear();
+            m_fifo_outputs.clear();
+        }
+
+        //! Performs the binaural decoding of a vector.
+        /**	The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the ears, the vectors have the vector size.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         */
+        void processBlock(const T* const* inputs, T* const* outputs) noexcept
+        {
+            const ulong fsize = m_fft_size;
+            const ulong vsize = m_vector_size;
+            const ulong ssize = m_spectrum_size;
+            const ulong psize = m_number_of_inputs * ssize;
+
+            m_current = (m_current + 1ul) % m_number_of_partitions;
+            T* spectra = m_spectra + m_current * psize;
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                T* frame = m_frames + i * fsize;
+                Signal<T>::move(fsize - vsize, frame + vsize, frame);
+                Signal<T>::copy(vsize, inputs[i], frame + fsize - vsize);
+                m_fft->forward(frame, spectra + i * ssize);
+            }
+
+            Signal<T>::clear(2ul * m_number_of_pairs * ssize, m_products);
+            for(ulong e = 0; e < 2ul; e++)
+            {
+                T* products = m_products + e * m_number_of_pairs * ssize;
+                for(ulong j = 0; j < m_number_of_partitions; j++)
+                {
+                    const ulong index = (m_current + m_number_of_partitions - j) % m_number_of_partitions;
+                    const T* x = m_spectra + index * psize;
+                    const T* h = m_responses + (e * m_number_of_partitions + j) * psize;
+                    for(ulong k = 0; k < m_number_of_pairs; k++)
+                    {
+                        Signal<T>::cmuladd(ssize >> 1, x + m_pairs[k * 2 + 1] * ssize, h + m_pairs[k * 2] * ssize, products + k * ssize);
+                    }
+                }
+            }
+
+            for(ulong i = 0; i < m_number_of_listeners; i++)
+            {
+                const T* rotations = m_rotations + i * m_number_of_pairs;
+                for(ulong e = 0; e < 2ul; e++)
+                {
+                    const T* products = m_products + e * m_number_of_pairs * ssize;
+                    Signal<T>::clear(ssize, m_accumulator);
+                    for(ulong k = 0; k < m_number_of_pairs; k++)
+                    {
+                        if(rotations[k] != T(0.))
+                        {
+                            Signal<T>::add(ssize, rotations[k], products + k * ssize, m_accumulator);
+                        }
+                    }
+                    m_fft->inverse(m_accumulator, m_buffer);
+                    Signal<T>::copy(vsize, m_buffer + fsize - vsize, outputs[i * 2ul + e]);
+                }
+            }
+        }
+
+    public:
+
+        //! The listeners constructor.
+        /**	The listeners constructor allocates and initialize the member values depending on a order of decomposition and a number of listeners, it uses the compiled responses, so it isn't available when HOA_NO_HRIR_TABLES is defined. The rendering must be computed before the processing.
+         @param     order               The order.
+         @param     numberOfListeners   The number of listeners.
+         */
+        Listeners(const ulong order, const ulong numberOfListeners) noexcept : Processor<D, T>::Harmonics(order),
+        m_number_of_listeners(numberOfListeners),
+        m_left(Hrir<D, T>::getLeftMatrix()),
+        m_right(Hrir<D, T>::getRightMatrix()),
+        m_rows(Hrir<D, T>::getNumberOfRows()),
+        m_columns(Hrir<D, T>::getNumberOfColumns()),
+        m_number_of_inputs(min(m_columns, Processor<D, T>::Harmonics::getNumberOfHarmonics())),
+        m_vector_size(0ul),
+        m_fft(nullptr),
+        m_frames(nullptr),
+        m_spectra(nullptr),
+        m_responses(nullptr),
+        m_products(nullptr),
+        m_accumulator(nullptr),
+        m_buffer(nullptr),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false)
+        {
+            initialize();
+        }
+
+        //! The listeners constructor with a set of responses.
+        /**	The listeners constructor uses the responses of a hrir file instead of the compiled responses, the file must be open and must stay open while the listeners are used. The harmonics over the number of columns of the file are ignored.
+         @param     order               The order.
+         @param     numberOfListeners   The number of listeners.
+         @param     hrir                The hrir file.
+         */
+        Listeners(const ulong order, const ulong numberOfListeners, const HrirFile<D, T>& hrir) noexcept : Processor<D, T>::Harmonics(order),
+        m_number_of_listeners(numberOfListeners),
+        m_left(hrir.getLeftMatrix()),
+        m_right(hrir.getRightMatrix()),
+        m_rows(hrir.getNumberOfRows()),
+        m_columns(hrir.getNumberOfColumns()),
+        m_number_of_inputs(min(m_columns, Processor<D, T>::Harmonics::getNumberOfHarmonics())),
+        m_vector_size(0ul),
+        m_fft(nullptr),
+        m_frames(nullptr),
+        m_spectra(nullptr),
+        m_responses(nullptr),
+        m_products(nullptr),
+        m_accumulator(nullptr),
+        m_buffer(nullptr),
+        m_fifo(nullptr),
+        m_count(0ul),
+        m_streaming(false)
+        {
+            initialize();
+        }
+
+        //! The listeners destructor.
+        /**	The listeners destructor free the memory.
+         */
+        ~Listeners() noexcept
+        {
+            clear();
+            delete [] m_pairs;
+            Signal<T>::free(m_rotations);
+            Signal<T>::free(m_vector);
+        }
+
+        //! Retrieve the number of listeners.
+        /** Retrieve the number of listeners.
+         @return The number of listeners.
+         */
+        inline ulong getNumberOfListeners() const noexcept
+        {
+            return m_number_of_listeners;
+        }
+
+        //! This method sets the rotation of the sound field of a listener.
+        /**	The coefficients of the rotation are retrieved from a rotation processor, so all its parameters can be used, for head tracking the rotation should be the inverse of the orientation of the head. The rotation is used from the next vector.
+         @param     listener    The index of the listener.
+         @param     rotate      The rotation processor.
+         */
+        inline void setRotation(const ulong listener, Rotate<D, T>& rotate) noexcept
+        {
+            const ulong size = Processor<D, T>::Harmonics::getNumberOfHarmonics();
+            T* rotations = m_rotations + listener * m_number_of_pairs;
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                Signal<T>::clear(size, m_vector);
+                m_vector[i] = 1.;
+                rotate.process(m_vector, m_vector + size);
+                for(ulong j = 0; j < m_number_of_pairs; j++)
+                {
+                    if(m_pairs[j * 2 + 1] == i)
+                    {
+                        rotations[j] = m_vector[size + m_pairs[j * 2]];
+                    }
+                }
+            }
+        }
+
+        //! This method sets the crop size of the responses.
+        /**	This method sets the crop size of the responses, 0 means the full responses. The rendering is computed again if it has already been computed.
+         @param size The crop size.
+         */
+        inline void setCropSize(const ulong size) noexcept
+        {
+            m_crop_size = (!size || size > m_rows) ? m_rows : size;
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the crop size of the responses.
+        /**	This method gets the crop size of the responses.
+         @return The crop size, 0 if the responses aren't cropped.
+         */
+        inline ulong getCropSize() const noexcept
+        {
+            return (m_crop_size == m_rows) ? 0ul : m_crop_size;
+        }
+
+        //! This method computes the spectra of the responses.
+        /**	This method allocates the memory, computes the spectra of the partitions of the responses and clears the state of the convolution. The size of the transforms is the smallest power of 2 greater or equal to twice the vector size.
+         @param vectorsize The vector size.
+         */
+        void computeRendering(const ulong vectorsize = 64)
+        {
+            clear();
+            m_vector_size           = max(vectorsize, 1ul);
+            m_number_of_partitions  = (m_crop_size + m_vector_size - 1ul) / m_vector_size;
+            m_fft_size              = 2ul;
+            while(m_fft_size < m_vector_size * 2ul)
+            {
+                m_fft_size <<= 1;
+            }
+            m_fft           = new Fft<T>(m_fft_size);
+            m_spectrum_size = m_fft->getSpectrumSize();
+            m_current       = 0ul;
+            m_frames        = Signal<T>::alloc(m_number_of_inputs * m_fft_size);
+            m_spectra       = Signal<T>::alloc(m_number_of_partitions * m_number_of_inputs * m_spectrum_size);
+            m_responses     = Signal<T>::alloc(2ul * m_number_of_partitions * m_number_of_inputs * m_spectrum_size);
+            m_products      = Signal<T>::alloc(2ul * m_number_of_pairs * m_spectrum_size);
+            m_accumulator   = Signal<T>::alloc(m_spectrum_size);
+            m_buffer        = Signal<T>::alloc(m_fft_size);
+            m_count         = 0ul;
+            m_fifo          = Signal<T>::alloc((m_number_of_inputs + 2ul * m_number_of_listeners) * m_vector_size);
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                m_fifo_inputs.push_back(m_fifo + i * m_vector_size);
+            }
+            for(ulong i = 0; i < 2ul * m_number_of_listeners; i++)
+            {
+                m_fifo_outputs.push_back(m_fifo + (m_number_of_inputs + i) * m_vector_size);
+            }
+            const T scale   = T(1.) / T(m_fft_size);
+            for(ulong e = 0; e < 2ul; e++)
+            {
+                const T* matrix = e ? m_right : m_left;
+                for(ulong p = 0; p < m_number_of_partitions; p++)
+                {
+                    for(ulong i = 0; i < m_number_of_inputs; i++)
+                    {
+                        Signal<T>::clear(m_fft_size, m_buffer);
+                        for(ulong j = 0; j < m_vector_size && p * m_vector_size + j < m_crop_size; j++)
+                        {
+                            m_buffer[j] = matrix[(p * m_vector_size + j) * m_columns + i] * scale;
+                        }
+                        m_fft->forward(m_buffer, m_responses + ((e * m_number_of_partitions + p) * m_number_of_inputs + i) * m_spectrum_size);
+                    }
+                }
+            }
+        }
+
+        //! This method sets the streaming mode.
+        /**	In the streaming mode, the samples are buffered until a complete vector so the vectors can have any number of samples and the decoding adds a latency of one vector. Otherwise the vectors must have the vector size used to compute the rendering and the decoding doesn't add any latency. The mode doesn't change during the processing, so the latency is known before the processing starts. The rendering is computed again if it has already been computed.
+         @param state The streaming mode.
+         */
+        inline void setStreaming(const bool state) noexcept
+        {
+            m_streaming = state;
+            if(m_vector_size)
+            {
+                computeRendering(m_vector_size);
+            }
+        }
+
+        //! This method gets the streaming mode.
+        /**	This method gets the streaming mode.
+         @return The streaming mode.
+         */
+        inline bool getStreaming() const noexcept
+        {
+            return m_streaming;
+        }
+
+        //! This method gets the latency of the decoding.
+        /**	This method gets the latency of the decoding, the vector size in the streaming mode, otherwise 0.
+         @return The latency in samples.
+         */
+        inline ulong getLatency() const noexcept
+        {
+            return m_streaming ? m_vector_size : 0ul;
+        }
+
+        //! This method performs the binaural decoding of all the listeners.
+        /**	You should use this method for not-in-place processing and sample by sample. The inputs array contains the samples of the harmonics and the outputs array contains the samples of the left and the right ears of each listener. The samples are buffered until a complete vector, so the sample processing should only be used in the streaming mode for the latency to be the one retrieved with getLatency().
+         @param     inputs  The input samples.
+         @param     outputs The output samples.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
+        {
+            for(ulong i = 0; i < m_number_of_inputs; i++)
+            {
+                m_fifo[i * m_vector_size + m_count] = inputs[i];
+            }
+            for(ulong i = 0; i < 2ul * m_number_of_listeners; i++)
+            {
+                outputs[i] = m_fifo_outputs[i][m_count];
+            }
+            if(++m_count == m_vector_size)
+            {
+                m_count = 0ul;
+                processBlock(m_fifo_inputs.data(), m_fifo_outputs.data());
+            }
+        }
+
+        //! This method performs the binaural decoding of all the listeners.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the harmonics and the outputs array contains the vectors of the left and the right ears of each listener, the left and the right ears of the first listener then of the second listener and so on. In the streaming mode, the number of samples can change from one call to another. Otherwise the number of samples must be the vector size used to compute the rendering, the outputs of vectors of another size are cleared.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(!m_streaming)
+            {
+                if(frames == m_vector_size)
+                {
+                    processBlock(inputs, outputs);
+                }
+                else
+                {
+                    for(ulong i = 0; i < 2ul * m_number_of_listeners; i++)
+                    {
+                        Signal<T>::clear(frames, outputs[i]);
+                    }
+                }
+                return;
+            }
+            ulong pos = 0ul;
+            while(pos < frames)
+            {
+                const ulong size = min(frames - pos, m_vector_size - m_count);
+                for(ulong i = 0; i < m_number_of_inputs; i++)
+                {
+                    Signal<T>::copy(size, inputs[i] + pos, m_fifo + i * m_vector_size + m_count);
+                }
+                for(ulong i = 0; i < 2ul * m_number_of_listeners; i++)
+                {
+                    Signal<T>::copy(size, m_fifo_outputs[i] + m_count, outputs[i] + pos);
+                }
+                m_count += size;
+                pos     += size;
+                if(m_count == m_vector_size)
+                {
+                    m_count = 0ul;
+                    processBlock(m_fifo_inputs.data(), m_fifo_outputs.data());
+                }
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,388 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_MATRICES_LIGHT
+#define DEF_HOA_MATRICES_LIGHT
+
+#include "Signal.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <mutex>
+
+namespace hoa
+{
+    //! The matrices class shares the matrices of the processors.
+    /** The matrices class is a process-wide cache of immutable matrices. The processors that compute the same matrix for the same configuration, for example several decoders with the same loudspeakers, share one matrix instead of computing and storing their own. A matrix is identified by a key that describes its configuration. The matrices are reference counted and the most recently released unreferenced matrices stay in the cache up to a capacity, so a processor created again doesn't compute its matrix again, while the least recently released ones are freed so the cache doesn't grow with every configuration computed. The cache can be saved to and loaded from a file to avoid the computation at startup. All the methods are thread-safe.
+     */
+    template <typename T> class Matrices
+    {
+    public:
+
+        //! The key of a matrix.
+        /** The key describes the configuration of a matrix, the name of the processor that computes it, the dimension, the order of decomposition and a set of values, for example the positions of the planewaves.
+         */
+        class Key
+        {
+        private:
+            string          m_name;
+            ulong           m_dimension;
+            ulong           m_order;
+            vector<double>  m_values;
+            uint64_t        m_hash;
+
+            inline void hash(const void* data, const ulong size) noexcept
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for(ulong i = 0; i < size; i++)
+                {
+                    m_hash = (m_hash ^ bytes[i]) * 1099511628211ull;
+                }
+            }
+
+        public:
+
+            //! The key constructor.
+            /** The key constructor initializes the key without values.
+             @param name        The name of the processor.
+             @param dimension   The dimension.
+             @param order       The order of decomposition.
+             */
+            Key(const string& name, const Dimension dimension, const ulong order) :
+            m_name(name),
+            m_dimension(ulong(dimension)),
+            m_order(order),
+            m_hash(14695981039346656037ull)
+            {
+                hash(m_name.data(), m_name.size());
+                hash(&m_dimension, sizeof(ulong));
+                hash(&m_order, sizeof(ulong));
+            }
+
+            //! Add a value to the key.
+            /** Add a value to the key.
+             @param value The value.
+             */
+            inline void add(const double value)
+            {
+                m_values.push_back(value);
+                hash(&value, sizeof(double));
+            }
+
+            //! Get the hash of the key.
+            /** Get the hash of the key.
+             @return The hash of the key.
+             */
+            inline uint64_t getHash() const noexcept
+            {
+                return m_hash;
+            }
+
+            //! Compare two keys.
+            /** The keys are ordered by hash then by configuration, so two keys are equivalent only if their configurations are the same.
+             */
+            inline bool operator<(const Key& other) const noexcept
+            {
+                if(m_hash != other.m_hash)
+                {
+                    return m_hash < other.m_hash;
+                }
+                if(m_name != other.m_name)
+                {
+                    return m_name < other.m_name;
+                }
+                if(m_dimension != other.m_dimension)
+                {
+                    return m_dimension < other.m_dimension;
+                }
+                if(m_order != other.m_order)
+                {
+                    return m_order < other.m_order;
+                }
+                return m_values < other.m_values;
+            }
+
+            friend class Matrices;
+        };
+
+    private:
+
+        struct Entry
+        {
+            T*      matrix;
+            ulong   size;
+            ulong   count;
+            typename list<const T*>::iterator position;
+        };
+
+        typedef pair<Key, ulong> Identifier;
+        typedef typename map<Identifier, Entry>::iterator iterator;
+
+        struct Storage
+        {
+            std::mutex              mutex;
+            map<Identifier, Entry>  entries;
+            map<const T*, iterator> matrices;
+            list<const T*>          unused;
+            ulong                   capacity;
+
+            Storage() : capacity(32ul) {}
+
+            ~Storage()
+            {
+                for(iterator it = entries.begin(); it != entries.end(); ++it)
+                {
+                    Signal<T>::free(it->second.matrix);
+                }
+            }
+        };
+
+        static Storage& storage()
+        {
+            static Storage instance;
+            return instance;
+        }
+
+        static void erase(Storage& s, iterator it)
+        {
+            if(!it->second.count)
+            {
+                s.unused.erase(it->second.position);
+            }
+            s.matrices.erase(it->second.matrix);
+            Signal<T>::free(it->second.matrix);
+            s.entries.erase(it);
+        }
+
+        static void evict(Storage& s, const ulong capacity)
+        {
+            while(s.unused.size() > capacity)
+            {
+                erase(s, s.matrices.find(s.unused.front())->second);
+            }
+        }
+
+        static inline void retain(Storage& s, iterator it)
+        {
+            if(!it->second.count++)
+            {
+                s.unused.erase(it->second.position);
+            }
+        }
+
+        template <typename V> static inline bool read(FILE* file, V& value) noexcept
+        {
+            return fread(&value, sizeof(V), 1, file) == 1;
+        }
+
+        template <typename V> static inline bool write(FILE* file, const V& value) noexcept
+        {
+            return fwrite(&value, sizeof(V), 1, file) == 1;
+        }
+
+    public:
+
+        //! Acquire a matrix.
+        /** Retrieve the matrix of a key and increment its reference count. A matrix is only retrieved if it has the expected number of values, so two configurations with the same key but with matrices of different sizes never share a matrix. The matrix must be released when it isn't used anymore.
+         @param key     The key of the matrix.
+         @param size    The number of values of the matrix.
+         @return The matrix or nullptr if the cache doesn't contain it.
+         */
+        static const T* acquire(const Key& key, const ulong size)
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            iterator it = s.entries.find(Identifier(key, size));
+            if(it == s.entries.end())
+            {
+                return nullptr;
+            }
+            retain(s, it);
+            return it->second.matrix;
+        }
+
+        //! Insert a matrix.
+        /** Insert a matrix computed for a key and increment its reference count. The cache takes the ownership of the matrix that must have been allocated with Signal::alloc(). If another matrix of the same size has been inserted for the same key in the meantime, the matrix is freed and the other one is returned. The matrix must be released when it isn't used anymore.
+         @param key     The key of the matrix.
+         @param matrix  The matrix.
+         @param size    The number of values of the matrix.
+         @return The shared matrix.
+         */
+        static const T* insert(const Key& key, T* matrix, const ulong size)
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            iterator it = s.entries.find(Identifier(key, size));
+            if(it != s.entries.end())
+            {
+                Signal<T>::free(matrix);
+            }
+            else
+            {
+                Entry entry = {matrix, size, 1ul, s.unused.end()};
+                it = s.entries.insert(make_pair(Identifier(key, size), entry)).first;
+                s.matrices[matrix] = it;
+                return matrix;
+            }
+            retain(s, it);
+            return it->second.matrix;
+        }
+
+        //! Release a matrix.
+        /** Decrement the reference count of a matrix. When the matrix isn't referenced anymore, it stays in the cache as the most recently released matrix and the least recently released matrices beyond the capacity are freed.
+         @param matrix The matrix, nullptr is ignored.
+         */
+        static void release(const T* matrix)
+        {
+            if(matrix)
+            {
+                Storage& s = storage();
+                std::lock_guard<std::mutex> lock(s.mutex);
+                typename map<const T*, iterator>::iterator it = s.matrices.find(matrix);
+                if(it != s.matrices.end() && it->second->second.count)
+                {
+                    Entry& entry = it->second->second;
+                    if(!--entry.count)
+                    {
+                        entry.position = s.unused.insert(s.unused.end(), matrix);
+                        evict(s, s.capacity);
+                    }
+                }
+            }
+        }
+
+        //! Free the unreferenced matrices.
+        /** Free the matrices that aren't used by any processor.
+         */
+        static void purge()
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            evict(s, 0ul);
+        }
+
+        //! Set the capacity of the cache.
+        /** Set the maximum number of unreferenced matrices kept in the cache, the least recently released matrices beyond the capacity are freed. The referenced matrices are never freed and aren't counted. The default capacity is 32.
+         @param capacity The number of unreferenced matrices.
+         */
+        static void setCapacity(const ulong capacity)
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.capacity = capacity;
+            evict(s, capacity);
+        }
+
+        //! Retrieve the capacity of the cache.
+        /** Retrieve the maximum number of unreferenced matrices kept in the cache.
+         @return The capacity.
+         */
+        static ulong getCapacity()
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            return s.capacity;
+        }
+
+        //! Retrieve the number of matrices.
+        /** Retrieve the number of matrices in the cache, referenced or not.
+         @return The number of matrices.
+         */
+        static ulong getNumberOfMatrices()
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            return s.entries.size();
+        }
+
+        //! Save the matrices to a file.
+        /** Save all the matrices of the cache to a file. The file is written to a temporary file then renamed, so a concurrent load never reads a partial file.
+         @param path The path of the file.
+         @return True if the file has been written.
+         */
+        static bool save(const char* path)
+        {
+            Storage& s = storage();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            const string temporary = string(path) + ".tmp";
+            FILE* file = fopen(temporary.c_str(), "wb");
+            if(!file)
+            {
+                return false;
+            }
+            bool valid = fwrite("HOAM", 1, 4, file) == 4;
+            valid = valid && write(file, uint32_t(1)) && write(file, uint32_t(sizeof(T))) && write(file, uint64_t(s.entries.size()));
+            for(iterator it = s.entries.begin(); valid && it != s.entries.end(); ++it)
+            {
+                const Key& key = it->first.first;
+                valid = write(file, uint64_t(key.m_name.size())) && fwrite(key.m_name.data(), 1, key.m_name.size(), file) == key.m_name.size();
+                valid = valid && write(file, uint64_t(key.m_dimension)) && write(file, uint64_t(key.m_order)) && write(file, uint64_t(key.m_values.size()));
+                valid = valid && fwrite(key.m_values.data(), sizeof(double), key.m_values.size(), file) == key.m_values.size();
+                valid = valid && write(file, uint64_t(it->second.size)) && fwrite(it->second.matrix, sizeof(T), it->second.size, file) == it->second.size;
+            }
+            valid = (fclose(file) == 0) && valid;
+            if(!valid || rename(temporary.c_str(), path) != 0)
+            {
+                remove(temporary.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        //! Load the matrices from a file.
+        /** Load the matrices of a file saved with the same precision into the cache. The matrices already in the cache are kept. The loaded matrices are unreferenced, so only the last ones up to the capacity are kept.
+         @param path The path of the file.
+         @return True if the file has been read.
+         */
+        static bool load(const char* path)
+        {
+            FILE* file = fopen(path, "rb");
+            if(!file)
+            {
+                return false;
+            }
+            char magic[4];
+            uint32_t version = 0, precision = 0;
+            uint64_t count = 0;
+            bool valid = fread(magic, 1, 4, file) == 4 && !memcmp(magic, "HOAM", 4);
+            valid = valid && read(file, version) && version == 1 && read(file, precision) && precision == sizeof(T) && read(file, count);
+            for(uint64_t i = 0; valid && i < count; i++)
+            {
+                uint64_t length = 0, dimension = 0, order = 0, number = 0, size = 0;
+                valid = read(file, length) && length < 4096;
+                string name(valid ? length : 0, '\0');
+                valid = valid && fread(&name[0], 1, length, file) == length;
+                valid = valid && read(file, dimension) && read(file, order) && read(file, number) && number < (uint64_t(1) << 24);
+                vector<double> values(valid ? number : 0);
+                valid = valid && fread(values.data(), sizeof(double), number, file) == number;
+                valid = valid && read(file, size) && size && size < (uint64_t(1) << 28);
+                if(valid)
+                {
+                    T* matrix = Signal<T>::alloc(ulong(size));
+                    valid = fread(matrix, sizeof(T), size, file) == size;
+                    if(valid)
+                    {
+                        Key key(name, Dimension(dimension), ulong(order));
+                        for(ulong j = 0; j < values.size(); j++)
+                        {
+                            key.add(values[j]);
+                        }
+                        release(insert(key, matrix, ulong(size)));
+                    }
+                    else
+                    {
+                        Signal<T>::free(matrix);
+                    }
+                }
+            }
+            fclose(file);
+            return valid;
+        }
+    };
+}
+
+#endif
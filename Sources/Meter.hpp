@@ -232,6 +232,39 @@ namespace hoa
         {
             process(input);
         }
+
+        //! This method update the signal values.
+        /** This method update the signal value for every channel to perform the meter calculation vector by vector.
+        @param inputs  The input vectors.
+        @param outputs The dummy output vectors.
+        @param frames  The number of samples of the vectors.
+         */
+        void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong j = 0; j < frames; j++)
+            {
+                if(m_ramp++ == m_vector_size)
+                {
+                    m_ramp = 0;
+                    for(ulong i = 0; i < size; i++)
+                    {
+                        m_channels_peaks[i] = fabs(inputs[i][j]);
+                    }
+                }
+                else
+                {
+                    for(ulong i = 0; i < size; i++)
+                    {
+                        const T peak = fabs(inputs[i][j]);
+                        if(peak > m_channels_peaks[i])
+                        {
+                            m_channels_peaks[i] = peak;
+                        }
+                    }
+                }
+            }
+        }
     };
 
     template <typename T> class Meter<Hoa3d, T> : public Processor<Hoa3d, T>::Planewaves
@@ -386,6 +419,39 @@ namespace hoa
             process(input);
         }
 
+        //! This method update the signal values.
+        /** This method update the signal value for every channel to perform the meter calculation vector by vector.
+        @param inputs  The input vectors.
+        @param outputs The dummy output vectors.
+        @param frames  The number of samples of the vectors.
+         */
+        void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong j = 0; j < frames; j++)
+            {
+                if(m_ramp++ == m_vector_size)
+                {
+                    m_ramp = 0;
+                    for(ulong i = 0; i < size; i++)
+                    {
+                        m_channels_peaks[i] = fabs(inputs[i][j]);
+                    }
+                }
+                else
+                {
+                    for(ulong i = 0; i < size; i++)
+                    {
+                        const T peak = fabs(inputs[i][j]);
+                        if(peak > m_channels_peaks[i])
+                        {
+                            m_channels_peaks[i] = peak;
+                        }
+                    }
+                }
+            }
+        }
+
         //! This method establish a model of a hoa meter.
         /** This method establish a model of a hoa meter.
          */
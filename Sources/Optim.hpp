@@ -18,6 +18,16 @@ namespace hoa
     {
     public:
 
+        //! The optimizations.
+        /** The enum defines the optimizations, it allows to fold an optimization into the matrix of an encoder or a decoder instead of using a dedicated processor.
+         */
+        enum Mode
+        {
+            BasicMode   = 0, /*!<  The basic optimization, no effect. */
+            MaxReMode   = 1, /*!<  The max-re optimization. */
+            InPhaseMode = 2  /*!<  The in-phase optimization. */
+        };
+
         //! The optim constructor.
         /**	The optim constructor allocates and initialize the member values to computes spherical harmonics weighted coefficients depending on a order of decomposition. The order must be at least 1.
          @param     order	The order.
@@ -36,6 +46,23 @@ namespace hoa
          */
         virtual void process(T const* inputs, T* outputs) noexcept;
 
+        //! This method performs the optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept;
+
+        //! Gets the weight of the harmonics of a degree.
+        /**	This method computes the weight applied by an optimization to the harmonics of a degree.
+         @param     mode    The optimization.
+         @param     order	The order of decomposition.
+         @param     degree	The degree of the harmonics.
+         @return    The weight.
+         */
+        static T getWeight(const Mode mode, const ulong order, const ulong degree) noexcept;
+
         //! The basic optim.
         /** The basic optim has no effect, it should be used (or not) with a perfect ambisonic channels arrangement where all the channels are to equal distance on a circle or a sphere, and for a listener placed at the perfect center of the circle of the sphere.
          */
@@ -125,6 +152,16 @@ namespace hoa
     {
     public:
 
+        //! The optimizations.
+        /** The enum defines the optimizations, it allows to fold an optimization into the matrix of an encoder or a decoder instead of using a dedicated processor.
+         */
+        enum Mode
+        {
+            BasicMode   = 0, /*!<  The basic optimization, no effect. */
+            MaxReMode   = 1, /*!<  The max-re optimization. */
+            InPhaseMode = 2  /*!<  The in-phase optimization. */
+        };
+
         //! The optim constructor.
         /**	The optim constructor allocates and initialize the member values to computes spherical harmonics weighted coefficients depending on a order of decomposition. The order must be at least 1.
          @param     order	The order.
@@ -149,6 +186,37 @@ namespace hoa
          */
         virtual void process(T const* inputs, T* outputs) noexcept = 0;
 
+        //! This method performs the optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
+        //! Gets the weight of the harmonics of a degree.
+        /**	This method computes the weight applied by an optimization to the harmonics of a degree.
+         @param     mode    The optimization.
+         @param     order	The order of decomposition.
+         @param     degree	The degree of the harmonics.
+         @return    The weight.
+         */
+        static inline T getWeight(const Mode mode, const ulong order, const ulong degree) noexcept
+        {
+            switch(mode)
+            {
+                case MaxReMode:
+                    return cos(T(degree) *  T(HOA_PI) / (T)(2. * order + 2.));
+                case InPhaseMode:
+                {
+                    const T facn = Math<T>::factorial(long(order));
+                    return facn / Math<T>::factorial(long(order - degree)) * facn / Math<T>::factorial(long(order + degree));
+                }
+                default:
+                    return T(1.);
+            }
+        }
+
         //! The basic optim.
         /** The basic optim has no effect, it should be used (or not) with a perfect ambisonic channels arrangement where all the channels are to equal distance on a circle or a sphere, and for a listener placed at the perfect center of the circle of the sphere.
          */
@@ -202,6 +270,23 @@ namespace hoa
                 (*outputs++)  = (*inputs++);
             }
         }
+
+        //! This method performs the basic optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                if(inputs[i] != outputs[i])
+                {
+                    Signal<T>::copy(frames, inputs[i], outputs[i]);
+                }
+            }
+        }
     };
 
     template <typename T> class Optim<Hoa2d, T>::MaxRe : public  Optim<Hoa2d, T>
@@ -212,7 +297,7 @@ namespace hoa
             T* vector = Signal<T>::alloc(order);
             for(ulong i = 1; i <= order; i++)
             {
-                vector[i-1] = cos(T(i) *  T(HOA_PI) / (T)(2. * order + 2.));
+                vector[i-1] = Optim<Hoa2d, T>::getWeight(Optim<Hoa2d, T>::MaxReMode, order, i);
             }
             return vector;
         }
@@ -255,6 +340,26 @@ namespace hoa
                 *(++outputs) = *(++inputs) * weight;
             }
         }
+
+        //! This method performs the max-re optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T* weights = m_weights;
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 1; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++, weights++)
+            {
+                Signal<T>::scale(frames, *weights, inputs[2 * i - 1], outputs[2 * i - 1]);
+                Signal<T>::scale(frames, *weights, inputs[2 * i], outputs[2 * i]);
+            }
+        }
     };
 
     template <typename T> class Optim<Hoa2d, T>::InPhase : public  Optim<Hoa2d, T>
@@ -263,10 +368,9 @@ namespace hoa
         static T* generate(const ulong order)
         {
             T* vector = Signal<T>::alloc(order);
-            const T facn = Math<T>::factorial(long(order));
             for(ulong i = 1; i <= order; i++)
             {
-                vector[i-1] = facn / Math<T>::factorial(long(order - i)) * facn / Math<T>::factorial(long(order + i));
+                vector[i-1] = Optim<Hoa2d, T>::getWeight(Optim<Hoa2d, T>::InPhaseMode, order, i);
             }
             return vector;
         }
@@ -309,12 +413,42 @@ namespace hoa
                 *(++outputs) = *(++inputs) * weight;
             }
         }
+
+        //! This method performs the in-phase optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T* weights = m_weights;
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 1; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++, weights++)
+            {
+                Signal<T>::scale(frames, *weights, inputs[2 * i - 1], outputs[2 * i - 1]);
+                Signal<T>::scale(frames, *weights, inputs[2 * i], outputs[2 * i]);
+            }
+        }
     };
 
     template <typename T> class Optim<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
     {
     public:
 
+        //! The optimizations.
+        /** The enum defines the optimizations, it allows to fold an optimization into the matrix of an encoder or a decoder instead of using a dedicated processor.
+         */
+        enum Mode
+        {
+            BasicMode   = 0, /*!<  The basic optimization, no effect. */
+            MaxReMode   = 1, /*!<  The max-re optimization. */
+            InPhaseMode = 2  /*!<  The in-phase optimization. */
+        };
+
         //! The optim constructor.
         /**	The optim constructor allocates and initialize the member values to computes spherical harmonics weighted coefficients depending on a order of decomposition. The order must be at least 1.
          @param     order	The order.
@@ -339,6 +473,37 @@ namespace hoa
          */
         virtual void process(T const* inputs, T* outputs) noexcept = 0;
 
+        //! This method performs the optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
+        //! Gets the weight of the harmonics of a degree.
+        /**	This method computes the weight applied by an optimization to the harmonics of a degree.
+         @param     mode    The optimization.
+         @param     order	The order of decomposition.
+         @param     degree	The degree of the harmonics.
+         @return    The weight.
+         */
+        static inline T getWeight(const Mode mode, const ulong order, const ulong degree) noexcept
+        {
+            switch(mode)
+            {
+                case MaxReMode:
+                    return cos(T(degree) *  T(HOA_PI) / (T)(2. * order + 2.));
+                case InPhaseMode:
+                {
+                    const T facn = Math<T>::factorial(long(order));
+                    return facn / Math<T>::factorial(long(order - degree)) * facn / Math<T>::factorial(long(order + degree));
+                }
+                default:
+                    return T(1.);
+            }
+        }
+
         //! The basic optim.
         /** The basic optim has no effect, it should be used (or not) with a perfect ambisonic channels arrangement where all the channels are to equal distance on a circle or a sphere, and for a listener placed at the perfect center of the circle of the sphere.
          */
@@ -395,6 +560,23 @@ namespace hoa
                 }
             }
         }
+
+        //! This method performs the basic optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                if(inputs[i] != outputs[i])
+                {
+                    Signal<T>::copy(frames, inputs[i], outputs[i]);
+                }
+            }
+        }
     };
 
     template <typename T> class Optim<Hoa3d, T>::MaxRe : public Optim<Hoa3d, T>
@@ -405,7 +587,7 @@ namespace hoa
             T* vector = Signal<T>::alloc(order);
             for(ulong i = 1; i <= order; i++)
             {
-                vector[i-1] = cos(T(i) *  T(HOA_PI) / (T)(2. * order + 2.));
+                vector[i-1] = Optim<Hoa3d, T>::getWeight(Optim<Hoa3d, T>::MaxReMode, order, i);
             }
             return vector;
         }
@@ -451,6 +633,28 @@ namespace hoa
                 }
             }
         }
+
+        //! This method performs the max-re optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T* weights = m_weights;
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 1; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++, weights++)
+            {
+                for(ulong j = i * i; j < (i + 1) * (i + 1); j++)
+                {
+                    Signal<T>::scale(frames, *weights, inputs[j], outputs[j]);    // Hamonic [i, [-i...i]]
+                }
+            }
+        }
     };
 
     template <typename T> class Optim<Hoa3d, T>::InPhase : public Optim<Hoa3d, T>
@@ -459,10 +663,9 @@ namespace hoa
         static T* generate(const ulong order)
         {
             T* vector = Signal<T>::alloc(order);
-            const T facn = Math<T>::factorial(long(order));
             for(ulong i = 1; i <= order; i++)
             {
-                vector[i-1] = facn / Math<T>::factorial(long(order - i)) * facn / Math<T>::factorial(long(order + i));
+                vector[i-1] = Optim<Hoa3d, T>::getWeight(Optim<Hoa3d, T>::InPhaseMode, order, i);
             }
             return vector;
         }
@@ -509,6 +712,28 @@ namespace hoa
                 }
             }
         }
+
+        //! This method performs the in-phase optimization.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T* weights = m_weights;
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 1; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++, weights++)
+            {
+                for(ulong j = i * i; j < (i + 1) * (i + 1); j++)
+                {
+                    Signal<T>::scale(frames, *weights, inputs[j], outputs[j]);    // Hamonic [i, [-i...i]]
+                }
+            }
+        }
     };
 
 #endif
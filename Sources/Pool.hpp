@@ -0,0 +1,433 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_POOL_LIGHT
+#define DEF_HOA_POOL_LIGHT
+
+#include "Signal.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hoa
+{
+    //! The pool class manages a set of persistent worker threads.
+    /** The pool runs a set of tasks on its worker threads and on the calling thread. The tasks are first divided in contiguous ranges, one per thread, and a thread that has finished its own range steals the remaining tasks of the others. The threads are created once by the constructor, running the tasks doesn't allocate memory and the workers wait for a new set of tasks by spinning on an atomic generation counter. A worker only sleeps on the condition after a while without tasks, so the calling thread only takes the lock to wake up sleeping workers, at the start or after a pause of the processing.
+     */
+    class Pool
+    {
+    public:
+
+        //! The task function.
+        /** The task function receives the data of the tasks, the index of the task and the index of the thread that performs the task. The index of the calling thread is 0.
+         */
+        typedef void (*Task)(void* data, const ulong task, const ulong thread);
+
+    private:
+
+        struct Range
+        {
+            std::atomic<ulong>  next;
+            ulong               end;
+            char                padding[64 - sizeof(std::atomic<ulong>) - sizeof(ulong)];
+        };
+
+        static const ulong      m_spin = 4096ul;
+
+        const ulong             m_number_of_threads;
+        vector<std::thread>     m_threads;
+        Range*                  m_ranges;
+        std::mutex              m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<ulong>      m_generation;
+        std::atomic<ulong>      m_sleeping;
+        std::atomic<bool>       m_exit;
+        std::atomic<ulong>      m_pending;
+        Task                    m_task;
+        void*                   m_data;
+
+        //! Performs the tasks of a thread.
+        /** Performs the tasks of the range of the thread then steals the tasks of the ranges of the other threads.
+         @param     thread  The index of the thread.
+         */
+        inline void work(const ulong thread) noexcept
+        {
+            for(ulong i = 0; i < m_number_of_threads; i++)
+            {
+                Range& range = m_ranges[(thread + i) % m_number_of_threads];
+                for(ulong task = range.next.fetch_add(1ul); task < range.end; task = range.next.fetch_add(1ul))
+                {
+                    m_task(m_data, task, thread);
+                }
+            }
+        }
+
+        //! The loop of a worker thread.
+        /** The worker spins until a new set of tasks or sleeps on the condition if it doesn't come, performs the tasks and notifies the calling thread.
+         @param     thread  The index of the thread.
+         */
+        inline void loop(const ulong thread) noexcept
+        {
+            ulong generation = 0;
+            for(;;)
+            {
+                for(ulong i = 0; i < m_spin && !m_exit.load() && m_generation.load() == generation; i++)
+                {
+                    std::this_thread::yield();
+                }
+                if(!m_exit.load() && m_generation.load() == generation)
+                {
+                    m_sleeping.fetch_add(1ul);
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    while(!m_exit.load() && m_generation.load() == generation)
+                    {
+                        m_condition.wait(lock);
+                    }
+                    m_sleeping.fetch_sub(1ul);
+                }
+                if(m_exit.load())
+                {
+                    return;
+                }
+                generation = m_generation.load();
+                work(thread);
+                m_pending.fetch_sub(1ul, std::memory_order_release);
+            }
+        }
+
+    public:
+
+        //! The pool constructor.
+        /**	The pool constructor creates the worker threads. The calling thread is counted as one of the threads, so a pool of one thread performs the tasks without worker.
+         @param     numberOfThreads	The number of threads, must be at least 1.
+         */
+        Pool(const ulong numberOfThreads) noexcept :
+        m_number_of_threads(max(numberOfThreads, 1ul)),
+        m_generation(0),
+        m_sleeping(0),
+        m_exit(false),
+        m_pending(0),
+        m_task(nullptr),
+        m_data(nullptr)
+        {
+            m_ranges = new Range[m_number_of_threads];
+            for(ulong i = 1; i < m_number_of_threads; i++)
+            {
+                m_threads.push_back(std::thread(&Pool::loop, this, i));
+            }
+        }
+
+        //! The pool destructor.
+        /**	The pool destructor stops and joins the worker threads.
+         */
+        ~Pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_exit = true;
+            }
+            m_condition.notify_all();
+            for(ulong i = 0; i < m_threads.size(); i++)
+            {
+                m_threads[i].join();
+            }
+            delete [] m_ranges;
+        }
+
+        //! Retrieve the number of threads.
+        /** Retrieve the number of threads including the calling thread.
+         @return The number of threads.
+         */
+        inline ulong getNumberOfThreads() const noexcept
+        {
+            return m_number_of_threads;
+        }
+
+        //! Performs a set of tasks.
+        /** Performs a set of tasks on the worker threads and on the calling thread. The method returns when all the tasks are performed. The method must not be called by several threads at the same time.
+         @param     task    The task function.
+         @param     data    The data of the tasks.
+         @param     tasks   The number of tasks.
+         */
+        inline void run(Task task, void* data, const ulong tasks) noexcept
+        {
+            if(m_number_of_threads == 1ul || tasks == 1ul)
+            {
+                for(ulong i = 0; i < tasks; i++)
+                {
+                    task(data, i, 0ul);
+                }
+                return;
+            }
+            for(ulong i = 0; i < m_number_of_threads; i++)
+            {
+                m_ranges[i].next.store(tasks * i / m_number_of_threads, std::memory_order_relaxed);
+                m_ranges[i].end = tasks * (i + 1) / m_number_of_threads;
+            }
+            m_task = task;
+            m_data = data;
+            m_pending.store(m_number_of_threads - 1ul, std::memory_order_relaxed);
+            m_generation.fetch_add(1ul);
+            if(m_sleeping.load())
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_condition.notify_all();
+            }
+            work(0ul);
+            while(m_pending.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    //! The partition class performs the product of a matrix by the vectors of the sources on the threads of a pool.
+    /** The sources are divided in slices that are the tasks of the pool. Each thread accumulates the harmonics of its slices in its own vectors and the vectors of the threads are summed with a tree reduction, harmonic by harmonic, at the end of the block.
+     */
+    template <typename T> class Partition
+    {
+    private:
+        Pool&           m_pool;
+        const ulong     m_number_of_sources;
+        const ulong     m_number_of_harmonics;
+        const ulong     m_vector_size;
+        ulong           m_slice;
+        ulong           m_number_of_slices;
+        T*              m_accumulators;
+        T*              m_ramps;
+        T*              m_packed;
+        T**             m_rows;
+        bool*           m_touched;
+        ulong*          m_threads;
+        ulong           m_number_of_touched;
+        const T**       m_inputs;
+        T**             m_outputs;
+        const T*        m_matrix;
+        const T*        m_previous;
+        ulong           m_frames;
+        T               m_start;
+        T               m_step;
+
+        //! Packs the slice of a matrix.
+        /** Packs the columns of the slice of a matrix in a contiguous matrix. If the previous matrix isn't null, the difference between the matrix and the previous matrix is packed.
+         @param     first       The index of the first source of the slice.
+         @param     size        The number of sources of the slice.
+         @param     matrix      The matrix.
+         @param     previous    The previous matrix or null.
+         @param     packed      The packed matrix.
+         */
+        inline void pack(const ulong first, const ulong size, const T* matrix, const T* previous, T* packed) const noexcept
+        {
+            for(ulong i = 0; i < m_number_of_harmonics; i++, packed += size)
+            {
+                const T* row = matrix + i * m_number_of_sources + first;
+                if(previous)
+                {
+                    const T* prev = previous + i * m_number_of_sources + first;
+                    for(ulong j = 0; j < size; j++)
+                    {
+                        packed[j] = row[j] - prev[j];
+                    }
+                }
+                else
+                {
+                    Signal<T>::copy(size, row, packed);
+                }
+            }
+        }
+
+        //! The task that encodes a slice of sources.
+        /** The first slice encoded by a thread overwrites the vectors of the thread, the next ones are accumulated. With a previous matrix, the slice is encoded with the previous matrix and the difference of the matrices is encoded in the ramp vectors of the thread.
+         @param     data    The partition.
+         @param     task    The index of the slice.
+         @param     thread  The index of the thread.
+         */
+        static void slice(void* data, const ulong task, const ulong thread) noexcept
+        {
+            Partition& p = *static_cast<Partition *>(data);
+            const ulong first   = task * p.m_slice;
+            const ulong size    = min(p.m_slice, p.m_number_of_sources - first);
+            const ulong nh      = p.m_number_of_harmonics;
+            T* packed           = p.m_packed + thread * p.m_slice * nh;
+            T** rows            = p.m_rows + thread * nh * 2;
+            p.pack(first, size, p.m_previous ? p.m_previous : p.m_matrix, nullptr, packed);
+            if(p.m_touched[thread])
+            {
+                Signal<T>::muladd(size, nh, p.m_frames, p.m_inputs + first, packed, rows);
+            }
+            else
+            {
+                Signal<T>::mul(size, nh, p.m_frames, p.m_inputs + first, packed, rows);
+            }
+            if(p.m_previous)
+            {
+                p.pack(first, size, p.m_matrix, p.m_previous, packed);
+                if(p.m_touched[thread])
+                {
+                    Signal<T>::muladd(size, nh, p.m_frames, p.m_inputs + first, packed, rows + nh);
+                }
+                else
+                {
+                    Signal<T>::mul(size, nh, p.m_frames, p.m_inputs + first, packed, rows + nh);
+                }
+            }
+            p.m_touched[thread] = true;
+        }
+
+        //! The task that sums the vectors of the threads for an harmonic.
+        /** The vectors of the threads that encoded at least one slice are summed pairwise, then the result is copied in the output vector and the ramp vectors are weighted and added.
+         @param     data    The partition.
+         @param     task    The index of the harmonic.
+         */
+        static void reduce(void* data, const ulong task, const ulong) noexcept
+        {
+            Partition& p = *static_cast<Partition *>(data);
+            const ulong nh = p.m_number_of_harmonics;
+            const ulong ntouched = p.m_number_of_touched;
+            for(ulong k = 0; k < (p.m_previous ? 2ul : 1ul); k++)
+            {
+                for(ulong stride = 1; stride < ntouched; stride *= 2)
+                {
+                    for(ulong i = 0; i + stride < ntouched; i += stride * 2)
+                    {
+                        const T* in = p.m_rows[(p.m_threads[i + stride] * 2 + k) * nh + task];
+                        T* out      = p.m_rows[(p.m_threads[i] * 2 + k) * nh + task];
+                        Signal<T>::add(p.m_frames, in, out);
+                    }
+                }
+            }
+            Signal<T>::copy(p.m_frames, p.m_rows[(p.m_threads[0] * 2) * nh + task], p.m_outputs[task]);
+            if(p.m_previous)
+            {
+                Signal<T>::rampadd(p.m_frames, p.m_start, p.m_step, p.m_rows[(p.m_threads[0] * 2 + 1) * nh + task], p.m_outputs[task]);
+            }
+        }
+
+        //! Performs the product for a part of the vectors.
+        /** Encodes the slices on the threads, then lists the threads that encoded at least one slice and sums their vectors.
+         */
+        inline void part() noexcept
+        {
+            const ulong nthreads = m_pool.getNumberOfThreads();
+            for(ulong i = 0; i < nthreads; i++)
+            {
+                m_touched[i] = false;
+            }
+            m_pool.run(&Partition::slice, this, m_number_of_slices);
+            m_number_of_touched = 0;
+            for(ulong i = 0; i < nthreads; i++)
+            {
+                if(m_touched[i])
+                {
+                    m_threads[m_number_of_touched++] = i;
+                }
+            }
+            m_pool.run(&Partition::reduce, this, m_number_of_harmonics);
+        }
+
+    public:
+
+        //! The partition constructor.
+        /**	The partition constructor allocates the vectors of the threads and the slices of the sources.
+         @param     pool                The pool of threads.
+         @param     numberOfSources     The number of sources.
+         @param     numberOfHarmonics   The number of harmonics.
+         @param     vectorsize          The maximum number of samples processed at once, bigger vectors are processed in several parts.
+         */
+        Partition(Pool& pool, const ulong numberOfSources, const ulong numberOfHarmonics, const ulong vectorsize) noexcept :
+        m_pool(pool),
+        m_number_of_sources(numberOfSources),
+        m_number_of_harmonics(numberOfHarmonics),
+        m_vector_size(max(vectorsize, 1ul)),
+        m_number_of_touched(0),
+        m_matrix(nullptr),
+        m_previous(nullptr),
+        m_frames(0),
+        m_start(0),
+        m_step(0)
+        {
+            const ulong nthreads = m_pool.getNumberOfThreads();
+            m_slice             = max(((m_number_of_sources + nthreads * 2 - 1) / (nthreads * 2) + 7ul) & ~7ul, 8ul);
+            m_number_of_slices  = (m_number_of_sources + m_slice - 1) / m_slice;
+            m_accumulators      = Signal<T>::alloc(nthreads * m_number_of_harmonics * m_vector_size);
+            m_ramps             = Signal<T>::alloc(nthreads * m_number_of_harmonics * m_vector_size);
+            m_packed            = Signal<T>::alloc(nthreads * m_number_of_harmonics * m_slice);
+            m_rows              = new T*[nthreads * m_number_of_harmonics * 2];
+            m_touched           = new bool[nthreads];
+            m_threads           = new ulong[nthreads];
+            m_inputs            = new const T*[m_number_of_sources];
+            m_outputs           = new T*[m_number_of_harmonics];
+            for(ulong i = 0; i < nthreads; i++)
+            {
+                for(ulong j = 0; j < m_number_of_harmonics; j++)
+                {
+                    m_rows[(i * 2) * m_number_of_harmonics + j]      = m_accumulators + (i * m_number_of_harmonics + j) * m_vector_size;
+                    m_rows[(i * 2 + 1) * m_number_of_harmonics + j]  = m_ramps + (i * m_number_of_harmonics + j) * m_vector_size;
+                }
+            }
+        }
+
+        //! The partition destructor.
+        /**	The partition destructor free the memory.
+         */
+        ~Partition() noexcept
+        {
+            Signal<T>::free(m_accumulators);
+            Signal<T>::free(m_ramps);
+            Signal<T>::free(m_packed);
+            delete [] m_rows;
+            delete [] m_touched;
+            delete [] m_threads;
+            delete [] m_inputs;
+            delete [] m_outputs;
+        }
+
+        //! Performs the product of the matrix by the vectors of the sources.
+        /**	The matrix contains the coefficients of the sources for each harmonic, the row of an harmonic contains the coefficients of all the sources.
+         @param     inputs   The vectors of the sources.
+         @param     matrix   The matrix.
+         @param     outputs  The vectors of the harmonics.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, const T* matrix, T** outputs, const ulong frames) noexcept
+        {
+            process(inputs, nullptr, matrix, outputs, frames);
+        }
+
+        //! Performs the product of the matrix interpolated from a previous matrix by the vectors of the sources.
+        /**	The coefficients are linearly interpolated from the previous matrix to the matrix over the vectors, the last samples are computed with the matrix. If the previous matrix is null, the matrix isn't interpolated.
+         @param     inputs   The vectors of the sources.
+         @param     previous The previous matrix.
+         @param     matrix   The matrix.
+         @param     outputs  The vectors of the harmonics.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, const T* previous, const T* matrix, T** outputs, const ulong frames) noexcept
+        {
+            m_matrix    = matrix;
+            m_previous  = previous;
+            m_step      = T(1.) / T(frames);
+            for(ulong i = 0; i < frames; i += m_vector_size)
+            {
+                m_frames = min(m_vector_size, frames - i);
+                m_start  = T(i + 1) * m_step;
+                for(ulong j = 0; j < m_number_of_sources; j++)
+                {
+                    m_inputs[j] = inputs[j] + i;
+                }
+                for(ulong j = 0; j < m_number_of_harmonics; j++)
+                {
+                    m_outputs[j] = outputs[j] + i;
+                }
+                part();
+            }
+        }
+    };
+}
+
+#endif
@@ -28,6 +28,14 @@ namespace hoa
          */
         virtual void process(const T* input, T* outputs) noexcept = 0;
 
+        //! This method performs the processing.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs and the outputs arrays contain a vector of samples for each input and each output and depends of the template and the processing.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
         class Harmonics;
 
         class Planewaves;
@@ -42,7 +50,6 @@ namespace hoa
 
         const ulong                 m_order_of_decomposition;
         const ulong                 m_number_of_harmonics;
-        vector< Harmonic<D, T> >    m_harmonics;
     public:
 
         //! The harmonics constructor.
@@ -53,10 +60,7 @@ namespace hoa
         m_order_of_decomposition(order),
         m_number_of_harmonics(Harmonic<D, T>::getNumberOfHarmonics(order))
         {
-            for(ulong i = 0; i < m_number_of_harmonics; i++)
-            {
-                m_harmonics.push_back(Harmonic<D, T>(i));
-            }
+            ;
         }
 
         //! The harmonics destructor.
@@ -64,7 +68,7 @@ namespace hoa
          */
         virtual ~Harmonics() noexcept
         {
-            m_harmonics.clear();
+            ;
         }
 
         //! Retrieve the order of decomposition.
@@ -94,7 +98,7 @@ namespace hoa
          */
         inline ulong getHarmonicDegree(const ulong index) const noexcept
         {
-            return m_harmonics[index].getDegree();
+            return Harmonic<D, T>::getDegree(index);
         }
 
         //! Retrieve the order of an harmonic.
@@ -106,7 +110,7 @@ namespace hoa
          */
         inline long getHarmonicOrder(const ulong index) const noexcept
         {
-            return m_harmonics[index].getOrder();
+            return Harmonic<D, T>::getOrder(index);
         }
 
         //! Retrieve the index of an harmonic.
@@ -131,7 +135,7 @@ namespace hoa
          */
         inline string getHarmonicName(const ulong index) const noexcept
         {
-            return m_harmonics[index].getName();
+            return Harmonic<D, T>(index).getName();
         }
         
         //! Get the normalization of an harmonic.
@@ -141,7 +145,7 @@ namespace hoa
          */
         inline T getHarmonicNormalization(const ulong index) const noexcept
         {
-            return m_harmonics[index].getNormalization();
+            return Harmonic<D, T>(index).getNormalization();
         }
         
         //! Get the semi-normalization of an harmonic.
@@ -151,7 +155,7 @@ namespace hoa
          */
         inline T getHarmonicSemiNormalization(const ulong index) const noexcept
         {
-            return m_harmonics[index].getSemiNormalization();
+            return Harmonic<D, T>(index).getSemiNormalization();
         }
 
         //! This method performs the processing.
@@ -163,6 +167,14 @@ namespace hoa
         {
             ;
         }
+
+        //! This method performs the processing.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs and the outputs arrays contain a vector of samples for each input and each output and depends of the template and the processing. Only the processors know their numbers of inputs and outputs, so each processor must implement this method.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
     };
 
 
@@ -453,6 +465,14 @@ namespace hoa
         {
             ;
         }
+
+        //! This method performs the processing.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs and the outputs arrays contain a vector of samples for each input and each output and depends of the template and the processing. Only the processors know their numbers of inputs and outputs, so each processor must implement this method.
+         @param     inputs  The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
     };
 }
 
@@ -8,6 +8,8 @@
 #define DEF_HOA_PROJECTOR_LIGHT
 
 #include "Encoder.hpp"
+#include "Optim.hpp"
+#include "Matrices.hpp"
 #include "Planewaves.hpp"
 
 namespace hoa
@@ -21,7 +23,7 @@ namespace hoa
     template <typename T> class Projector<Hoa2d, T> : public Encoder<Hoa2d, T>::Basic, public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        T*  m_matrix;
+        const T* m_matrix;
     public:
 
         //! The regular constructor.
@@ -33,13 +35,24 @@ namespace hoa
         Encoder<Hoa2d, T>::Basic(order),
         Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
-            const T factor = 1. / (T)(Encoder<Hoa2d, T>::getDecompositionOrder() + 1.);
+            typename Matrices<T>::Key key("regular", Hoa2d, Encoder<Hoa2d, T>::getDecompositionOrder());
+            key.add(double(Optim<Hoa2d, T>::BasicMode));
             for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                Encoder<Hoa2d, T>::Basic::setAzimuth(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
-                Encoder<Hoa2d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
-                m_matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
+                key.add(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
+            }
+            m_matrix = Matrices<T>::acquire(key, Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            if(!m_matrix)
+            {
+                T* matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+                const T factor = 1. / (T)(Encoder<Hoa2d, T>::getDecompositionOrder() + 1.);
+                for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+                {
+                    Encoder<Hoa2d, T>::Basic::setAzimuth(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
+                    Encoder<Hoa2d, T>::Basic::process(&factor, matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+                    matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
+                }
+                m_matrix = Matrices<T>::insert(key, matrix, Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
             }
         }
 
@@ -48,7 +61,7 @@ namespace hoa
          */
         ~Projector()
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
         }
 
         //! This method performs the decoding.
@@ -60,6 +73,17 @@ namespace hoa
         {
             Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
+
+        //! This method performs the decoding.
+        /**	You should use this method for not-in-place processing and performs the regular decoding vector by vector. The inputs array contains the vectors of the spherical harmonics and the minimum size must be the number of harmonics and the outputs array contains the vectors of the channels and the minimum size must be the number of channels.
+         @param     inputs  The input vectors of the harmonics.
+         @param     outputs The output vectors of the channels.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), frames, inputs, m_matrix, outputs);
+        }
     };
 #endif
 }
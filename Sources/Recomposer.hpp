@@ -72,12 +72,25 @@ namespace hoa
         {
             Signal<T>::mul(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), Encoder<Hoa2d, T>::getNumberOfHarmonics(), inputs, m_matrix, outputs);
         }
+
+        //! This method performs the recomposition.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the planewaves and the minimum size must be the number of planewaves and the outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs  The input vectors of the planewaves.
+         @param     outputs The output vectors of the harmonics.
+         @param     frames  The number of samples of the vectors.
+         */
+        void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            Signal<T>::mul(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), Encoder<Hoa2d, T>::getNumberOfHarmonics(), frames, inputs, m_matrix, outputs);
+        }
     };
 
     template <typename T> class Recomposer<Hoa2d, T, Fisheye> : public Processor<Hoa2d, T>::Harmonics, public Processor<Hoa2d, T>::Planewaves
     {
     private:
         vector< typename Encoder<Hoa2d, T>::Basic*>m_encoders;
+        T*  m_matrix;
+        T*  m_vector;
     public:
         //! The decoder constructor.
         /**	The decoder constructor allocates and initialize the base classes.
@@ -88,6 +101,8 @@ namespace hoa
         Processor<Hoa2d, T>::Harmonics(order),
         Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
         {
+            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_vector = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
             for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_encoders.push_back(new typename Encoder<Hoa2d, T>::Basic(order));
@@ -104,6 +119,8 @@ namespace hoa
                 delete m_encoders[i];
             }
             m_encoders.clear();
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_vector);
         }
 
         //! Set the fishEye value.
@@ -141,12 +158,33 @@ namespace hoa
                 m_encoders[i]->processAdd(++inputs, outputs);
             }
         }
+
+        //! This method performs the recomposition.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the planewaves and the minimum size must be the number of planewaves and the outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs  The input vectors of the planewaves.
+         @param     outputs The output vectors of the harmonics.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T factor = 1.;
+            const ulong nharmo = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            const ulong nplane = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong i = 0; i < nplane; i++)
+            {
+                m_encoders[i]->process(&factor, m_vector);
+                Signal<T>::copy(nharmo, m_vector, 1ul, m_matrix + i, nplane);
+            }
+            Signal<T>::mul(nplane, nharmo, frames, inputs, m_matrix, outputs);
+        }
     };
 
     template <typename T> class Recomposer<Hoa2d, T, Free> : public Processor<Hoa2d, T>::Harmonics, public Processor<Hoa2d, T>::Planewaves
     {
     private:
         vector< typename Encoder<Hoa2d, T>::DC* >  m_encoders;
+        T*  m_matrix;
+        T*  m_vector;
     public:
         //! The decoder constructor.
         /**	The decoder constructor allocates and initialize the base classes.
@@ -157,6 +195,8 @@ namespace hoa
         Processor<Hoa2d, T>::Harmonics(order),
         Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
         {
+            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_vector = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
             for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_encoders.push_back(new typename Encoder<Hoa2d, T>::DC(order));
@@ -174,6 +214,8 @@ namespace hoa
                 delete m_encoders[i];
             }
             m_encoders.clear();
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_vector);
         }
 
         //! Set the azimuth.
@@ -227,6 +269,25 @@ namespace hoa
                 m_encoders[i]->processAdd(++inputs, outputs);
             }
         }
+
+        //! This method performs the recomposition.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the planewaves and the minimum size must be the number of planewaves and the outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs  The input vectors of the planewaves.
+         @param     outputs The output vectors of the harmonics.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const T factor = 1.;
+            const ulong nharmo = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            const ulong nplane = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong i = 0; i < nplane; i++)
+            {
+                m_encoders[i]->process(&factor, m_vector);
+                Signal<T>::copy(nharmo, m_vector, 1ul, m_matrix + i, nplane);
+            }
+            Signal<T>::mul(nplane, nharmo, frames, inputs, m_matrix, outputs);
+        }
     };
 #endif
 }
@@ -11,8 +11,8 @@
 
 namespace hoa
 {
-    //! The rotate class rotates a sound field in the harmonics domain (2d available only).
-    /** The rotate should be used to rotate a sound field by weighting the harmonics depending on the rotation.
+    //! The rotate class rotates a sound field in the harmonics domain.
+    /** The rotate should be used to rotate a sound field by weighting the harmonics depending on the rotation. In 2d, the rotation is only around the z axis. In 3d, the rotation is defined by the yaw, the pitch and the roll or by a quaternion.
      */
     template <Dimension D, typename T> class Rotate : public  Processor<D, T>::Harmonics
     {
@@ -54,6 +54,14 @@ namespace hoa
          @param     outputs  The output array.
          */
         virtual void process(const T* inputs, T* outputs) noexcept;
+
+        //! This method performs the rotation.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept;
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -61,9 +69,52 @@ namespace hoa
     template <typename T> class Rotate<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
     {
     private:
+        static const ulong m_chunk = 64ul;
         T   m_yaw;
         T   m_cosx;
         T   m_sinx;
+        T*  m_phasors;
+
+        //! Rotates the harmonics of a part of the vectors with a yaw for each sample.
+        /** The cosines and the sines of the yaw of each sample are in the first two rows of the phasors. The phasors of the next degrees are computed by complex multiplies in the last two rows, so the rotation of each degree only costs a few multiplies per sample.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     offset   The index of the first sample.
+         @param     size     The number of samples.
+         */
+        inline void rotate(const T** inputs, T** outputs, const ulong offset, const ulong size) noexcept
+        {
+            const T* cos_x  = m_phasors;
+            const T* sin_x  = m_phasors + m_chunk;
+            T* cos_l        = m_phasors + 2 * m_chunk;
+            T* sin_l        = m_phasors + 3 * m_chunk;
+            Signal<T>::copy(size, cos_x, cos_l);
+            Signal<T>::copy(size, sin_x, sin_l);
+            for(ulong i = 1; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            {
+                if(i > 1)
+                {
+                    for(ulong j = 0; j < size; j++)
+                    {
+                        const T tcos_l = cos_l[j];
+                        cos_l[j] = tcos_l * cos_x[j] - sin_l[j] * sin_x[j];
+                        sin_l[j] = tcos_l * sin_x[j] + sin_l[j] * cos_x[j];
+                    }
+                }
+                const T* in_sin = inputs[2 * i - 1] + offset;
+                const T* in_cos = inputs[2 * i] + offset;
+                T* out_sin      = outputs[2 * i - 1] + offset;
+                T* out_cos      = outputs[2 * i] + offset;
+                for(ulong j = 0; j < size; j++)
+                {
+                    const T sig_sin = in_sin[j];
+                    const T sig_cos = in_cos[j];
+                    out_sin[j] = sin_l[j] * sig_cos + cos_l[j] * sig_sin;
+                    out_cos[j] = cos_l[j] * sig_cos - sin_l[j] * sig_sin;
+                }
+            }
+        }
+
     public:
 
         //! The rotate constructor.
@@ -72,7 +123,8 @@ namespace hoa
          */
         Rotate(const ulong order) noexcept : Processor<Hoa2d, T>::Harmonics(order)
         {
-            ;
+            m_phasors = Signal<T>::alloc(4 * m_chunk);
+            setYaw(0.);
         }
 
         //! The Rotate destructor.
@@ -80,7 +132,7 @@ namespace hoa
          */
         ~Rotate() noexcept
         {
-            ;
+            Signal<T>::free(m_phasors);
         }
 
         //! This method sets the angle of the rotation around the z axis, the yaw value,
@@ -128,8 +180,453 @@ namespace hoa
                 (*outputs++) = cos_x * (*inputs++) - sin_x * sig;
             }
         }
+
+        //! This method performs the rotation.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            T cos_x = m_cosx;
+            T sin_x = m_sinx;
+            T tcos_x = cos_x;
+
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 1; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            {
+                if(i > 1)
+                {
+                    cos_x = tcos_x * m_cosx - sin_x * m_sinx;
+                    sin_x = tcos_x * m_sinx + sin_x * m_cosx;
+                    tcos_x = cos_x;
+                }
+                const T* in_sin = inputs[2 * i - 1];
+                const T* in_cos = inputs[2 * i];
+                T* out_sin      = outputs[2 * i - 1];
+                T* out_cos      = outputs[2 * i];
+                for(ulong j = 0; j < frames; j++)
+                {
+                    const T sig_sin = in_sin[j];
+                    const T sig_cos = in_cos[j];
+                    out_sin[j] = sin_x * sig_cos + cos_x * sig_sin;
+                    out_cos[j] = cos_x * sig_cos - sin_x * sig_sin;
+                }
+            }
+        }
+
+        //! This method performs the rotation with a yaw that changes linearly over the vectors.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector with an automation of the yaw. The yaw of each sample is interpolated linearly from the start value to the end value that is reached at the last sample. The cosine and the sine of the yaw are computed once per part of 64 samples, the phasors of the samples in between are computed by a complex oscillator. After the processing, the yaw is the end value, even if there is no sample.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         @param     start    The yaw before the first sample.
+         @param     end      The yaw at the last sample.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames, const T start, const T end) noexcept
+        {
+            if(!frames)
+            {
+                setYaw(end);
+                return;
+            }
+            const T step    = (end - start) / T(frames);
+            const T cos_d   = std::cos(step);
+            const T sin_d   = std::sin(step);
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 0; i < frames; i += m_chunk)
+            {
+                const ulong size = min(m_chunk, frames - i);
+                T cos_x = std::cos(start + T(i + 1) * step);
+                T sin_x = std::sin(start + T(i + 1) * step);
+                for(ulong j = 0; j < size; j++)
+                {
+                    const T tcos_x = cos_x;
+                    m_phasors[j]            = cos_x;
+                    m_phasors[m_chunk + j]  = sin_x;
+                    cos_x = tcos_x * cos_d - sin_x * sin_d;
+                    sin_x = tcos_x * sin_d + sin_x * cos_d;
+                }
+                rotate(inputs, outputs, i, size);
+            }
+            setYaw(end);
+        }
+
+        //! This method performs the rotation with a yaw for each sample.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector with a sample accurate automation of the yaw. The cosine and the sine are computed once per sample, the phasors of the degrees are computed by complex multiplies. After the processing, the yaw is the one of the last sample, an empty vector doesn't change it.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         @param     yaws     The yaw of each sample.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames, const T* yaws) noexcept
+        {
+            if(!frames)
+            {
+                return;
+            }
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong i = 0; i < frames; i += m_chunk)
+            {
+                const ulong size = min(m_chunk, frames - i);
+                for(ulong j = 0; j < size; j++)
+                {
+                    m_phasors[j]            = std::cos(yaws[i + j]);
+                    m_phasors[m_chunk + j]  = std::sin(yaws[i + j]);
+                }
+                rotate(inputs, outputs, i, size);
+            }
+            setYaw(yaws[frames - 1]);
+        }
+    };
+
+    template <typename T> const ulong Rotate<Hoa2d, T>::m_chunk;
+
+    template <typename T> class Rotate<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
+    {
+    private:
+        static const ulong m_chunk = 64ul;
+        T   m_yaw;
+        T   m_pitch;
+        T   m_roll;
+        T   m_rotation[9];
+        T*  m_matrix;
+        T*  m_vector;
+        T*  m_buffer;
+        vector<const T*> m_rows;
+        vector<T*> m_outputs;
+
+        //! Get a coefficient of the rotation matrix of the degree 1 with orthonormal harmonics.
+        inline T getFirst(const long m, const long n) const noexcept
+        {
+            return m_matrix[1 + (m + 1) * 3 + (n + 1)];
+        }
+
+        //! Get a coefficient of the rotation matrix of the previous degree with orthonormal harmonics.
+        inline T getPrevious(const T* matrix, const long l, const long m, const long n) const noexcept
+        {
+            return matrix[(m + l) * (2 * l + 1) + (n + l)];
+        }
+
+        //! The P function of the recursion of Ivanic and Ruedenberg.
+        inline T getP(const T* matrix, const long i, const long l, const long a, const long b) const noexcept
+        {
+            if(b == l)
+            {
+                return getFirst(i, 1) * getPrevious(matrix, l - 1, a, l - 1) - getFirst(i, -1) * getPrevious(matrix, l - 1, a, -l + 1);
+            }
+            else if(b == -l)
+            {
+                return getFirst(i, 1) * getPrevious(matrix, l - 1, a, -l + 1) + getFirst(i, -1) * getPrevious(matrix, l - 1, a, l - 1);
+            }
+            return getFirst(i, 0) * getPrevious(matrix, l - 1, a, b);
+        }
+
+        //! Computes a coefficient of the rotation matrix of a degree with orthonormal harmonics.
+        inline T getCoefficient(const T* matrix, const long l, const long m, const long n) const noexcept
+        {
+            const long  am      = labs(m);
+            const T     d       = (m == 0) ? T(1.) : T(0.);
+            const T     denom   = (labs(n) == l) ? T(2 * l * (2 * l - 1)) : T((l + n) * (l - n));
+            const T     u       = std::sqrt(T((l + m) * (l - m)) / denom);
+            const T     v       = T(0.5) * std::sqrt((T(1.) + d) * T((l + am - 1) * (l + am)) / denom) * (T(1.) - T(2.) * d);
+            const T     w       = T(-0.5) * std::sqrt(T((l - am - 1) * (l - am)) / denom) * (T(1.) - d);
+            T result = 0;
+            if(u != 0)
+            {
+                result += u * getP(matrix, 0, l, m, n);
+            }
+            if(v != 0)
+            {
+                if(m == 0)
+                {
+                    result += v * (getP(matrix, 1, l, 1, n) + getP(matrix, -1, l, -1, n));
+                }
+                else if(m > 0)
+                {
+                    const T d1 = (m == 1) ? T(1.) : T(0.);
+                    result += v * (getP(matrix, 1, l, m - 1, n) * std::sqrt(T(1.) + d1) - getP(matrix, -1, l, -m + 1, n) * (T(1.) - d1));
+                }
+                else
+                {
+                    const T d1 = (m == -1) ? T(1.) : T(0.);
+                    result += v * (getP(matrix, 1, l, m + 1, n) * (T(1.) - d1) + getP(matrix, -1, l, -m - 1, n) * std::sqrt(T(1.) + d1));
+                }
+            }
+            if(w != 0)
+            {
+                if(m > 0)
+                {
+                    result += w * (getP(matrix, 1, l, m + 1, n) + getP(matrix, -1, l, -m - 1, n));
+                }
+                else
+                {
+                    result += w * (getP(matrix, 1, l, m - 1, n) - getP(matrix, -1, l, -m + 1, n));
+                }
+            }
+            return result;
+        }
+
+        //! Computes the rotation matrices of the degrees.
+        /** The rotation matrices are computed recursively from the rotation matrix of the degree 1 for orthonormal harmonics without the Condon-Shortley phase, then they are weighted for the normalization of the harmonics of the encoders. The orthonormal harmonics are defined for the axes \f$(y, -x, -z)\f$.
+         */
+        void computeMatrix() noexcept
+        {
+            const T* r = m_rotation;
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            // The rotation matrix in the axes (y, -x, -z) then reordered for the harmonics of degree 1.
+            const T ortho[9] = { r[4], -r[3], -r[5],
+                                -r[1],  r[0],  r[2],
+                                -r[7],  r[6],  r[8]};
+            m_matrix[0] = T(1.);
+            T* first = m_matrix + 1;
+            first[0] = ortho[4]; first[1] = ortho[5]; first[2] = ortho[3];
+            first[3] = ortho[7]; first[4] = ortho[8]; first[5] = ortho[6];
+            first[6] = ortho[1]; first[7] = ortho[2]; first[8] = ortho[0];
+
+            T* previous = first;
+            T* matrix   = first + 9;
+            for(long l = 2; l <= long(order); l++)
+            {
+                for(long m = -l; m <= l; m++)
+                {
+                    for(long n = -l; n <= l; n++)
+                    {
+                        matrix[(m + l) * (2 * l + 1) + (n + l)] = getCoefficient(previous, l, m, n);
+                    }
+                }
+                previous = matrix;
+                matrix  += (2 * l + 1) * (2 * l + 1);
+            }
+
+            const T norm = T(std::sqrt(4. * HOA_PI));
+            matrix = first;
+            for(long l = 1; l <= long(order); l++)
+            {
+                for(long m = -l; m <= l; m++)
+                {
+                    const T cm = (m == 0) ? norm : ((labs(m) % 2) ? T(-1.) : T(1.));
+                    for(long n = -l; n <= l; n++)
+                    {
+                        const T cn = (n == 0) ? norm : ((labs(n) % 2) ? T(-1.) : T(1.));
+                        matrix[(m + l) * (2 * l + 1) + (n + l)] *= cm / cn;
+                    }
+                }
+                matrix += (2 * l + 1) * (2 * l + 1);
+            }
+        }
+
+        //! Computes the rotation matrix in the cartesian coordinates from the yaw, the pitch and the roll.
+        void computeRotation() noexcept
+        {
+            const T cy = std::cos(m_yaw),   sy = std::sin(m_yaw);
+            const T cp = std::cos(m_pitch), sp = std::sin(m_pitch);
+            const T cr = std::cos(m_roll),  sr = std::sin(m_roll);
+            m_rotation[0] = cy * cr - sy * sp * sr; m_rotation[1] = -sy * cp;  m_rotation[2] = cy * sr + sy * sp * cr;
+            m_rotation[3] = sy * cr + cy * sp * sr; m_rotation[4] = cy * cp;   m_rotation[5] = sy * sr - cy * sp * cr;
+            m_rotation[6] = -cp * sr;               m_rotation[7] = sp;        m_rotation[8] = cp * cr;
+            computeMatrix();
+        }
+
+    public:
+
+        //! The rotate constructor.
+        /**	The rotate constructor allocates and initialize the member values to computes spherical harmonics rotation depending on a order of decomposition. The order must be at least 1.
+         @param     order	The order.
+         */
+        Rotate(const ulong order) noexcept : Processor<Hoa3d, T>::Harmonics(order),
+        m_yaw(0.),
+        m_pitch(0.),
+        m_roll(0.)
+        {
+            m_matrix = Signal<T>::alloc((order + 1) * (2 * order + 1) * (2 * order + 3) / 3);
+            m_vector = Signal<T>::alloc(4 * order + 2);
+            m_buffer = Signal<T>::alloc((2 * order + 1) * m_chunk);
+            for(ulong i = 0; i < 2 * order + 1; i++)
+            {
+                m_rows.push_back(m_buffer + i * m_chunk);
+            }
+            m_outputs.resize(2 * order + 1);
+            computeRotation();
+        }
+
+        //! The Rotate destructor.
+        /**	The Rotate destructor free the memory.
+         */
+        ~Rotate() noexcept
+        {
+            Signal<T>::free(m_matrix);
+            Signal<T>::free(m_vector);
+            Signal<T>::free(m_buffer);
+        }
+
+        //! This method sets the angle of the rotation around the z axis, the yaw value,
+        /** The yaw is equivalent to a rotation around the z axis, the value is in radian and should be between 0 and 2π.
+         @param     yaw The yaw value.
+         */
+        inline void setYaw(const T yaw) noexcept
+        {
+            m_yaw = yaw;
+            computeRotation();
+        }
+
+        //! Get the angle of the rotation around the z axis, the yaw value.
+        /** The method returns the angle of the rotation around the z axis, the yaw value, in radian between 0 and 2π.
+         @return     The yaw value.
+         */
+        inline T getYaw() const noexcept
+        {
+            return Math<T>::wrap_twopi(m_yaw);
+        }
+
+        //! This method sets the angle of the rotation around the x axis, the pitch value,
+        /** The pitch is equivalent to a rotation around the x axis, the axis from the left to the right, the value is in radian and should be between 0 and 2π.
+         @param     pitch The pitch value.
+         */
+        inline void setPitch(const T pitch) noexcept
+        {
+            m_pitch = pitch;
+            computeRotation();
+        }
+
+        //! Get the angle of the rotation around the x axis, the pitch value.
+        /** The method returns the angle of the rotation around the x axis, the pitch value, in radian between 0 and 2π.
+         @return     The pitch value.
+         */
+        inline T getPitch() const noexcept
+        {
+            return Math<T>::wrap_twopi(m_pitch);
+        }
+
+        //! This method sets the angle of the rotation around the y axis, the roll value,
+        /** The roll is equivalent to a rotation around the y axis, the axis from the back to the front, the value is in radian and should be between 0 and 2π.
+         @param     roll The roll value.
+         */
+        inline void setRoll(const T roll) noexcept
+        {
+            m_roll = roll;
+            computeRotation();
+        }
+
+        //! Get the angle of the rotation around the y axis, the roll value.
+        /** The method returns the angle of the rotation around the y axis, the roll value, in radian between 0 and 2π.
+         @return     The roll value.
+         */
+        inline T getRoll() const noexcept
+        {
+            return Math<T>::wrap_twopi(m_roll);
+        }
+
+        //! This method sets the yaw, the pitch and the roll values.
+        /** The rotation is the roll around the y axis, then the pitch around the x axis and then the yaw around the z axis. The values are in radian.
+         @param     yaw     The yaw value.
+         @param     pitch   The pitch value.
+         @param     roll    The roll value.
+         */
+        inline void setYawPitchRoll(const T yaw, const T pitch, const T roll) noexcept
+        {
+            m_yaw   = yaw;
+            m_pitch = pitch;
+            m_roll  = roll;
+            computeRotation();
+        }
+
+        //! This method sets the rotation with a quaternion.
+        /** The quaternion \f$w + xi + yj + zk\f$ is normalized and defines the rotation in the cartesian coordinates of the planewaves, the x axis from the left to the right, the y axis from the back to the front and the z axis from the bottom to the top. The yaw, the pitch and the roll values are updated.
+         @param     w   The real part of the quaternion.
+         @param     x   The first imaginary part of the quaternion.
+         @param     y   The second imaginary part of the quaternion.
+         @param     z   The third imaginary part of the quaternion.
+         */
+        inline void setQuaternion(const T w, const T x, const T y, const T z) noexcept
+        {
+            const T norm = std::sqrt(w * w + x * x + y * y + z * z);
+            if(norm > 0)
+            {
+                const T a = w / norm, b = x / norm, c = y / norm, d = z / norm;
+                m_rotation[0] = T(1.) - T(2.) * (c * c + d * d); m_rotation[1] = T(2.) * (b * c - a * d); m_rotation[2] = T(2.) * (b * d + a * c);
+                m_rotation[3] = T(2.) * (b * c + a * d); m_rotation[4] = T(1.) - T(2.) * (b * b + d * d); m_rotation[5] = T(2.) * (c * d - a * b);
+                m_rotation[6] = T(2.) * (b * d - a * c); m_rotation[7] = T(2.) * (c * d + a * b); m_rotation[8] = T(1.) - T(2.) * (b * b + c * c);
+                m_pitch = std::asin(Math<T>::clip(m_rotation[7], T(-1.), T(1.)));
+                m_yaw   = std::atan2(-m_rotation[1], m_rotation[4]);
+                m_roll  = std::atan2(-m_rotation[6], m_rotation[8]);
+                computeMatrix();
+            }
+        }
+
+        //! This method performs the rotation.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. The harmonics of each degree are multiplied by the rotation matrix of the degree, the harmonics of different degrees are never mixed.
+         @param     inputs   The input array.
+         @param     outputs  The output array.
+         */
+        inline void process(const T* inputs, T* outputs) noexcept override
+        {
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            const T* matrix = m_matrix + 1;
+            (*outputs++) = (*inputs++);
+            for(ulong l = 1; l <= order; l++)
+            {
+                const ulong size = 2 * l + 1;
+                Signal<T>::copy(size, inputs, m_vector);
+                Signal<T>::mul(size, size, m_vector, matrix, outputs);
+                inputs  += size;
+                outputs += size;
+                matrix  += size * size;
+            }
+        }
+
+        //! This method performs the rotation.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs array and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The vectors of each degree are multiplied by the rotation matrix of the degree, for in-place processing the input vectors of the degree are first copied in parts.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            const T* matrix = m_matrix + 1;
+            if(inputs[0] != outputs[0])
+            {
+                Signal<T>::copy(frames, inputs[0], outputs[0]);
+            }
+            for(ulong l = 1; l <= order; l++)
+            {
+                const ulong size  = 2 * l + 1;
+                const ulong first = l * l;
+                if(inputs[first] != outputs[first])
+                {
+                    Signal<T>::mul(size, size, frames, inputs + first, matrix, outputs + first);
+                }
+                else
+                {
+                    for(ulong i = 0; i < frames; i += m_chunk)
+                    {
+                        const ulong csize = min(m_chunk, frames - i);
+                        for(ulong k = 0; k < size; k++)
+                        {
+                            Signal<T>::copy(csize, inputs[first + k] + i, m_buffer + k * m_chunk);
+                            m_outputs[k] = outputs[first + k] + i;
+                        }
+                        Signal<T>::mul(size, size, csize, m_rows.data(), matrix, m_outputs.data());
+                    }
+                }
+                matrix += size * size;
+            }
+        }
     };
 
+    template <typename T> const ulong Rotate<Hoa3d, T>::m_chunk;
+
 #endif
 }
 
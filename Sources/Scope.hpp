@@ -8,6 +8,8 @@
 #define DEF_HOA_SCOPE_LIGHT
 
 #include "Encoder.hpp"
+#include "Optim.hpp"
+#include "Matrices.hpp"
 #include "Planewaves.hpp"
 
 namespace hoa
@@ -55,6 +57,14 @@ namespace hoa
          */
         virtual inline void process(const T* inputs) noexcept = 0;
 
+        //! This method performs the spherical/circular harmonics projection of the last samples of vectors.
+        /**	You should use this method to compute the projection of the spherical/circular harmonics over an ambisonic sphere within a vector processing. Only the last samples of the vectors are projected. The inputs array contains the vectors of the spherical/circular harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The dummy output vectors (null).
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override = 0;
+
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -62,8 +72,9 @@ namespace hoa
     template <typename T> class Scope<Hoa2d, T> : public Encoder<Hoa2d, T>::Basic, protected Processor<Hoa2d, T>::Planewaves
     {
     private:
-        T*  m_matrix;
+        const T* m_matrix;
         T*  m_vector;
+        T*  m_inputs;
         T   m_maximum;
     public:
 
@@ -76,8 +87,9 @@ namespace hoa
         Encoder<Hoa2d, T>::Basic(order),
         Processor<Hoa2d, T>::Planewaves(numberOfPoints)
         {
-            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix = nullptr;
             m_vector = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_inputs = Signal<T>::alloc(Encoder<Hoa2d, T>::getNumberOfHarmonics());
             computeRendering();
         }
 
@@ -86,8 +98,9 @@ namespace hoa
          */
         ~Scope() noexcept
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
             Signal<T>::free(m_vector);
+            Signal<T>::free(m_inputs);
         }
 
         //! Set the offset.
@@ -111,18 +124,35 @@ namespace hoa
          */
         void computeRendering() noexcept
         {
-            const T factor = 1. / (T)(Encoder<Hoa2d, T>::getDecompositionOrder() + 1.);
             for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                Encoder<Hoa2d, T>::Basic::setAzimuth(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
-                Encoder<Hoa2d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
-                m_matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
+                m_vector[i] = 0.;
             }
+            m_maximum = 0;
+            typename Matrices<T>::Key key("regular", Hoa2d, Encoder<Hoa2d, T>::getDecompositionOrder());
+            key.add(double(Optim<Hoa2d, T>::BasicMode));
             for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                m_vector[i] = 0.;
+                key.add(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
             }
-            m_maximum = 0;
+            const T* shared = Matrices<T>::acquire(key, Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            const T factor = 1. / (T)(Encoder<Hoa2d, T>::getDecompositionOrder() + 1.);
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            {
+                Encoder<Hoa2d, T>::Basic::setAzimuth(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
+                Encoder<Hoa2d, T>::Basic::process(&factor, matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+                matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
+            }
+            shared = Matrices<T>::insert(key, matrix, Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
         }
 
         //! Retrieve the number of points.
@@ -217,6 +247,24 @@ namespace hoa
                 Signal<T>::scale(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), (1. / m_maximum), m_vector);
             }
         }
+
+        //! This method performs the circular harmonics projection of the last samples of vectors.
+        /**	You should use this method to compute the projection of the circular harmonics over an ambisonics circle within a vector processing. Only the last samples of the vectors are projected. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The dummy output vectors (null).
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(frames)
+            {
+                for(ulong i = 0; i < Encoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
+                {
+                    m_inputs[i] = inputs[i][frames - 1];
+                }
+                process(m_inputs);
+            }
+        }
     };
 
     template <typename T> class Scope<Hoa3d, T> : public Encoder<Hoa3d, T>::Basic, protected Processor<Hoa3d, T>::Planewaves
@@ -224,8 +272,9 @@ namespace hoa
     private:
         const ulong m_number_of_rows;
         const ulong m_number_of_columns;
-        T*  m_matrix;
+        const T* m_matrix;
         T*  m_vector;
+        T*  m_inputs;
         T   m_maximum;
     public:
 
@@ -252,8 +301,9 @@ namespace hoa
                 }
             }
 
-            m_matrix = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_matrix = nullptr;
             m_vector = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_inputs = Signal<T>::alloc(Encoder<Hoa3d, T>::getNumberOfHarmonics());
             computeRendering();
         }
 
@@ -262,8 +312,9 @@ namespace hoa
          */
         ~Scope() noexcept
         {
-            Signal<T>::free(m_matrix);
+            Matrices<T>::release(m_matrix);
             Signal<T>::free(m_vector);
+            Signal<T>::free(m_inputs);
         }
 
         //! Retrieve the number of rows.
@@ -383,30 +434,47 @@ namespace hoa
          */
         void computeRendering() noexcept
         {
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            {
+                m_vector[i] = 0.;
+            }
+            m_maximum = 0;
+            typename Matrices<T>::Key key("scope", Hoa3d, Encoder<Hoa3d, T>::getDecompositionOrder());
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            {
+                key.add(Processor<Hoa3d, T>::Planewaves::getPlanewaveAzimuth(i));
+                key.add(Processor<Hoa3d, T>::Planewaves::getPlanewaveElevation(i));
+            }
+            const T* shared = Matrices<T>::acquire(key, Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            if(shared)
+            {
+                Matrices<T>::release(m_matrix);
+                m_matrix = shared;
+                return;
+            }
+            T* matrix = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa3d, T>::getNumberOfHarmonics());
             const T factor = 12.5 / (T)(Encoder<Hoa3d, T>::getNumberOfHarmonics());
             for(ulong i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 Encoder<Hoa3d, T>::Basic::setAzimuth(Processor<Hoa3d, T>::Planewaves::getPlanewaveAzimuth(i));
                 Encoder<Hoa3d, T>::Basic::setElevation(Processor<Hoa3d, T>::Planewaves::getPlanewaveElevation(i));
-                Encoder<Hoa3d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+                Encoder<Hoa3d, T>::Basic::process(&factor, matrix + i * Encoder<Hoa3d, T>::getNumberOfHarmonics());
                 for(ulong j = 0; j < Encoder<Hoa3d, T>::getNumberOfHarmonics(); j++)
                 {
                     const ulong l = Encoder<Hoa3d, T>::getHarmonicDegree(j);
                     if(Encoder<Hoa3d, T>::getHarmonicOrder(j) == 0)
                     {
-                        m_matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= (2. * l + 1.);
+                        matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= (2. * l + 1.);
                     }
                     else
                     {
-                        m_matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
+                        matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
                     }
                 }
             }
-            for(ulong i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
-            {
-                m_vector[i] = 0.;
-            }
-            m_maximum = 0;
+            shared = Matrices<T>::insert(key, matrix, Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa3d, T>::getNumberOfHarmonics());
+            Matrices<T>::release(m_matrix);
+            m_matrix = shared;
         }
 
         //! This method performs the spherical harmonics projection with single precision.
@@ -438,6 +506,24 @@ namespace hoa
                 Signal<T>::scale(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), (1. / m_maximum), m_vector);
             }
         }
+
+        //! This method performs the spherical harmonics projection of the last samples of vectors.
+        /**	You should use this method to compute the projection of the spherical harmonics over an ambisonic sphere within a vector processing. Only the last samples of the vectors are projected. The inputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics.
+         @param     inputs   The input vectors.
+         @param     outputs  The dummy output vectors (null).
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            if(frames)
+            {
+                for(ulong i = 0; i < Encoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
+                {
+                    m_inputs[i] = inputs[i][frames - 1];
+                }
+                process(m_inputs);
+            }
+        }
     };
 
 #endif
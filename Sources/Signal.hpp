@@ -8,6 +8,7 @@
 #define DEF_HOA_SIGNAL_LIGHT
 
 #include "Defs.hpp"
+#include "Simd.hpp"
 
 namespace hoa
 {
@@ -63,7 +64,7 @@ namespace hoa
 
 
         //! Multiplies a matrix by a vector.
-        /** Multiplies a matrix by a vector.
+        /** Multiplies a matrix by a vector. The method uses the vectorized kernel of the processor when one is available.
         @param colsize  The size of the input vector and the number of columns.
         @param rowsize  The size of the output vector and the number of rows.
         @param in      The input vector.
@@ -72,6 +73,12 @@ namespace hoa
          */
         static inline void mul(const ulong colsize, const ulong rowsize, const T* in, const T* in2, T* output) noexcept
         {
+            static const typename Simd<T>::MatrixVector kernel = Simd<T>::getMatrixVector();
+            if(kernel)
+            {
+                kernel(colsize, rowsize, in, in2, output);
+                return;
+            }
             for(ulong i = 0ul; i < rowsize; i++)
             {
                 T result = 0;
@@ -90,40 +97,111 @@ namespace hoa
         }
 
         //! Multiplies a matrix by a matrix.
-        /** Multiplies a matrix by a matrix.
-        @param m        The number of rows in the first matrix and the number of columns in the second matrix.
-        @param n        The number of rows in the second matrix and the number of column in the output matrix.
-        @param l        The number of columns in the first matrix and the number of rows in the output matrix.
+        /** Multiplies a matrix by a matrix. The first matrix has m rows and l columns, the second matrix has l rows and n columns and the output matrix has m rows and n columns. The matrices are stored row by row and the output matrix can't be one of the input matrices.
+        @param m        The number of rows of the first matrix and of the output matrix.
+        @param n        The number of columns of the second matrix and of the output matrix.
+        @param l        The number of columns of the first matrix and the number of rows of the second matrix.
         @param in1      The first matrix.
         @param in2      The second matrix.
         @param output   The output matrix.
          */
         static inline void mul(const ulong m, const ulong n, const ulong l, const T* in1, const T* in2, T* output) noexcept
         {
-            ulong i, j, k;
-            memset(output, 0, m * n * sizeof(T));
-            T* out = output;
-            for(k = 0; k < l; k++)
+            mul(false, false, m, n, l, in1, in2, output);
+        }
+
+        //! Multiplies a matrix or its transpose by a matrix or its transpose.
+        /** Multiplies a matrix or its transpose by a matrix or its transpose. The output matrix has m rows and n columns. If transpose1 is false the first matrix has m rows and l columns, otherwise it has l rows and m columns and its transpose is used. If transpose2 is false the second matrix has l rows and n columns, otherwise it has n rows and l columns and its transpose is used. The matrices are stored row by row and the output matrix can't be one of the input matrices. The product is computed by panels of the output matrix: the blocks of the first matrix and the transposed blocks of the second matrix are packed in the workspace of the calling thread, then the tiles are computed by the block kernel of the processor.
+        @param transpose1   If the first matrix should be transposed.
+        @param transpose2   If the second matrix should be transposed.
+        @param m            The number of rows of the output matrix.
+        @param n            The number of columns of the output matrix.
+        @param l            The inner dimension of the product.
+        @param in1          The first matrix.
+        @param in2          The second matrix.
+        @param output       The output matrix.
+         */
+        static inline void mul(const bool transpose1, const bool transpose2, const ulong m, const ulong n, const ulong l, const T* in1, const T* in2, T* output) noexcept
+        {
+            const ulong mc = 64ul, kc = 256ul, nc = 1024ul;
+            const T* rows[256];
+            T* outs[64];
+            if(!l)
+            {
+                clear(m * n, output);
+                return;
+            }
+            const ulong size1 = std::min(m, mc) * std::min(l, kc);
+            const ulong size2 = transpose2 ? std::min(l, kc) * std::min(n, nc) : 0ul;
+            T* packed1 = getWorkspace(size1 + size2);
+            T* packed2 = transpose2 ? packed1 + size1 : nullptr;
+            for(ulong j0 = 0ul; j0 < n; j0 += nc)
             {
-                out = output;
-                for(i = 0; i < m; i++)
+                const ulong nb = std::min(nc, n - j0);
+                for(ulong k0 = 0ul; k0 < l; k0 += kc)
                 {
-                    const T g0 = in1[l * i + k];
-                    if(g0 != 0)
+                    const ulong kb = std::min(kc, l - k0);
+                    for(ulong k = 0ul; k < kb; k++)
+                    {
+                        if(transpose2)
+                        {
+                            copy(nb, in2 + j0 * l + k0 + k, l, packed2 + k * nb, 1ul);
+                            rows[k] = packed2 + k * nb;
+                        }
+                        else
+                        {
+                            rows[k] = in2 + (k0 + k) * n + j0;
+                        }
+                    }
+                    for(ulong i0 = 0ul; i0 < m; i0 += mc)
                     {
-                        const T* in = in2+n*k;
-                        for(j = n; j; j -= 8, out += 8, in += 8)
+                        const ulong mb = std::min(mc, m - i0);
+                        for(ulong i = 0ul; i < mb; i++)
                         {
-                            const T f0 = in[0] * g0, f1 = in[1] * g0, f2 = in[2] * g0, f3 = in[3] * g0;
-                            const T f4 = in[4] * g0, f5 = in[5] * g0, f6 = in[6] * g0, f7 = in[7] * g0;
-                            out[0] += f0; out[1] += f1; out[2] += f2; out[3] += f3;
-                            out[4] += f4; out[5] += f5; out[6] += f6; out[7] += f7;
+                            if(transpose1)
+                            {
+                                copy(kb, in1 + k0 * m + i0 + i, m, packed1 + i * kb, 1ul);
+                            }
+                            else
+                            {
+                                copy(kb, in1 + (i0 + i) * l + k0, packed1 + i * kb);
+                            }
+                            outs[i] = output + (i0 + i) * n + j0;
                         }
+                        block(kb, mb, nb, rows, packed1, outs, k0 > 0ul);
                     }
                 }
             }
         }
 
+        //! Multiplies a matrix by a set of vectors.
+        /** Multiplies a matrix by a set of vectors. Each output vector is the sum of the input vectors weighted by a row of the matrix. The output vectors can't be the input vectors. The method uses the vectorized kernel of the processor when one is available, the kernel computes tiles of several rows and frames so the matrix and the input frames stay in the cache for the whole block.
+        @param colsize  The number of input vectors and the number of columns.
+        @param rowsize  The number of output vectors and the number of rows.
+        @param frames   The size of the vectors.
+        @param inputs   The input vectors.
+        @param matrix   The matrix.
+        @param outputs  The output vectors.
+         */
+        static inline void mul(const ulong colsize, const ulong rowsize, const ulong frames, const T** inputs, const T* matrix, T** outputs) noexcept
+        {
+            block(colsize, rowsize, frames, inputs, matrix, outputs, false);
+        }
+
+        //! Multiplies a matrix by a set of vectors and adds the result to other vectors.
+        /** Multiplies a matrix by a set of vectors and adds the result to other vectors. Each output vector is incremented by the sum of the input vectors weighted by a row of the matrix. The output vectors can't be the input vectors.
+        @param colsize  The number of input vectors and the number of columns.
+        @param rowsize  The number of output vectors and the number of rows.
+        @param frames   The size of the vectors.
+        @param inputs   The input vectors.
+        @param matrix   The matrix.
+        @param outputs  The output vectors.
+         */
+        static inline void muladd(const ulong colsize, const ulong rowsize, const ulong frames, const T** inputs, const T* matrix, T** outputs) noexcept
+        {
+            block(colsize, rowsize, frames, inputs, matrix, outputs, true);
+        }
+
         //! Gets the maximum of the absolute values of a vector.
         /** Gets the maximum of the absolute values of a vector.
         @param   vectorsize   The size of the vector.
@@ -174,6 +252,26 @@ namespace hoa
             }
         }
 
+        //! Multiplies each element of a vector by a factor and copies the result into an other.
+        /** Multiplies each element of a vector by a factor and copies the result into an other. The vectors can be the same.
+        @param   size   The size of the vectors.
+        @param   factor The factor of the scale.
+        @param   in     The source vector.
+        @param   out    The destination vector.
+         */
+        static inline void scale(const ulong size, const T factor, const T* in, T* out) noexcept
+        {
+            for(size_t i = size>>3; i; --i, in += 8, out += 8)
+            {
+                out[0] = in[0] * factor; out[1] = in[1] * factor; out[2] = in[2] * factor; out[3] = in[3] * factor;
+                out[4] = in[4] * factor; out[5] = in[5] * factor; out[6] = in[6] * factor; out[7] = in[7] * factor;
+            }
+            for(size_t i = size&7; i; --i, in++, out++)
+            {
+                out[0] = in[0] * factor;
+            }
+        }
+
         //! Clears a vector.
         /** Clears a vector.
         @param   size   The size of the vector.
@@ -195,6 +293,17 @@ namespace hoa
             memcpy(dest, source, size * sizeof(T));
         }
 
+        //! Moves a vector into an other that can overlap it.
+        /** Copies a vector into an other, the vectors can overlap.
+         @param   size   The size of the vectors.
+         @param   source The source vector.
+         @param   dest   The destination vector.
+         */
+        static inline void move(const ulong size, const T* source, T* dest) noexcept
+        {
+            memmove(dest, source, size * sizeof(T));
+        }
+
         //! Copies a vector into an other.
         /** Copies a vector into an other.
          @param   size   The size of the vectors.
@@ -234,6 +343,58 @@ namespace hoa
             }
         }
 
+        //! Adds a vector multiplied by a factor to an other.
+        /** Adds a vector multiplied by a factor to an other value by value.
+        @param   size   The size of the vectors.
+        @param   factor The factor of the source vector.
+        @param   in     The source vector.
+        @param   out    The destination vector.
+         */
+        static inline void add(const ulong size, const T factor, const T* in, T* out) noexcept
+        {
+            for(size_t i = size>>3; i; --i, in += 8, out += 8)
+            {
+                out[0] += in[0] * factor; out[1] += in[1] * factor; out[2] += in[2] * factor; out[3] += in[3] * factor;
+                out[4] += in[4] * factor; out[5] += in[5] * factor; out[6] += in[6] * factor; out[7] += in[7] * factor;
+            }
+            for(size_t i = size&7; i; --i, in++, out++)
+            {
+                out[0] += in[0] * factor;
+            }
+        }
+
+        //! Multiplies each element of a vector by a linear ramp and copies the result into an other.
+        /** Multiplies the element \f$i\f$ of a vector by \f$start + i \times step\f$ and copies the result into an other. The vectors can be the same.
+         @param   size   The size of the vectors.
+         @param   start  The first value of the ramp.
+         @param   step   The increment of the ramp.
+         @param   in     The source vector.
+         @param   out    The destination vector.
+         */
+        static inline void ramp(const ulong size, const T start, const T step, const T* in, T* out) noexcept
+        {
+            for(ulong i = 0ul; i < size; i++)
+            {
+                out[i] = in[i] * (start + T(i) * step);
+            }
+        }
+
+        //! Multiplies each element of a vector by a linear ramp and adds the result to an other.
+        /** Multiplies the element \f$i\f$ of a vector by \f$start + i \times step\f$ and adds the result to an other.
+         @param   size   The size of the vectors.
+         @param   start  The first value of the ramp.
+         @param   step   The increment of the ramp.
+         @param   in     The source vector.
+         @param   out    The destination vector.
+         */
+        static inline void rampadd(const ulong size, const T start, const T step, const T* in, T* out) noexcept
+        {
+            for(ulong i = 0ul; i < size; i++)
+            {
+                out[i] += in[i] * (start + T(i) * step);
+            }
+        }
+
         //! Adds a vector to an other.
         /** Adds a vector to an other.
          @param   size   The size of the vectors.
@@ -254,6 +415,22 @@ namespace hoa
             }
         }
 
+        //! Multiplies two complex vectors and adds the result to an other.
+        /** Multiplies two complex vectors value by value and adds the result to an other. The complex values are stored with interleaved real and imaginary parts.
+         @param   size   The number of complex values of the vectors.
+         @param   in1    The first vector.
+         @param   in2    The second vector.
+         @param   out    The destination vector.
+         */
+        static inline void cmuladd(const ulong size, const T* in1, const T* in2, T* out) noexcept
+        {
+            for(ulong i = 0ul; i < size; i++, in1 += 2, in2 += 2, out += 2)
+            {
+                out[0] += in1[0] * in2[0] - in1[1] * in2[1];
+                out[1] += in1[0] * in2[1] + in1[1] * in2[0];
+            }
+        }
+
         //! Computes the dot product of two vectors.
         /** Computes the dot product of two vectors.
         @param   size   The size of the vectors.
@@ -275,6 +452,88 @@ namespace hoa
             }
             return result;
         }
+
+    private:
+
+        //! The workspace class owns a buffer of a thread.
+        /** The buffer of the workspace grows to the biggest size requested by the thread and is freed when the thread ends.
+         */
+        class Workspace
+        {
+        private:
+            T*      m_data;
+            ulong   m_size;
+
+        public:
+            Workspace() noexcept : m_data(nullptr), m_size(0ul) {}
+
+            ~Workspace() noexcept
+            {
+                Signal<T>::free(m_data);
+            }
+
+            //! Gets the buffer.
+            /** Gets the buffer, the buffer is only reallocated if it's smaller than the requested size.
+             @param size The size of the buffer.
+             @return The buffer.
+             */
+            inline T* get(const ulong size) noexcept
+            {
+                if(size > m_size)
+                {
+                    Signal<T>::free(m_data);
+                    m_data = Signal<T>::alloc(size);
+                    m_size = size;
+                }
+                return m_data;
+            }
+        };
+
+        //! Gets the workspace of the calling thread.
+        /** Gets the buffer of the workspace of the calling thread, so the products of matrices don't allocate memory once the buffer has grown to the biggest size used by the thread.
+         @param size The size of the buffer.
+         @return The buffer.
+         */
+        static inline T* getWorkspace(const ulong size) noexcept
+        {
+            static thread_local Workspace workspace;
+            return workspace.get(size);
+        }
+
+        //! Multiplies a matrix by a set of vectors with the block kernel of the processor.
+        /** Multiplies a matrix by a set of vectors with the block kernel of the processor. The frames that don't fit the tiles of the kernel are computed with the scalar methods.
+        @param colsize      The number of input vectors and the number of columns.
+        @param rowsize      The number of output vectors and the number of rows.
+        @param frames       The size of the vectors.
+        @param inputs       The input vectors.
+        @param matrix       The matrix.
+        @param outputs      The output vectors.
+        @param accumulate   If the result is added to the output vectors.
+         */
+        static inline void block(const ulong colsize, const ulong rowsize, const ulong frames, const T** inputs, const T* matrix, T** outputs, const bool accumulate) noexcept
+        {
+            static const typename Simd<T>::MatrixBlock kernel = Simd<T>::getMatrixBlock();
+            const ulong offset = kernel ? kernel(colsize, rowsize, frames, inputs, matrix, outputs, accumulate) : 0ul;
+            if(offset < frames)
+            {
+                const ulong size = frames - offset;
+                for(ulong i = 0ul; i < rowsize; i++, matrix += colsize)
+                {
+                    if(accumulate)
+                    {
+                        add(size, matrix[0], inputs[0] + offset, outputs[i] + offset);
+                    }
+                    else
+                    {
+                        scale(size, matrix[0], inputs[0] + offset, outputs[i] + offset);
+                    }
+                    for(ulong j = 1ul; j < colsize; j++)
+                    {
+                        add(size, matrix[j], inputs[j] + offset, outputs[i] + offset);
+                    }
+                }
+            }
+        }
     };
 }
 
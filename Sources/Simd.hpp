@@ -0,0 +1,977 @@
+/*
+// Copyright (c) 2012-2015 Eliott Paris, Julien Colafrancesco, Thomas Le Meur & Pierre Guillot, CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_SIMD_LIGHT
+#define DEF_HOA_SIMD_LIGHT
+
+#include "Defs.hpp"
+
+// Define HOA_NO_SIMD to always use the scalar implementations of the signal class.
+#ifndef HOA_NO_SIMD
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HOA_SIMD_X86
+#define HOA_SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define HOA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace hoa
+{
+    //! The simd class provides the vectorized kernels of the signal class.
+    /** The simd class selects at runtime the best kernel for the instruction sets supported by the processor (AVX-512, AVX2 with FMA or SSE2 on x86 and NEON on ARM). If no kernel is available for a type or a processor, the getters return a null pointer and the signal class uses its scalar implementation.
+     */
+    template <typename T> class Simd
+    {
+    public:
+
+        //! The type of the matrix by vector kernels.
+        typedef void (*MatrixVector)(const ulong colsize, const ulong rowsize, const T* in, const T* matrix, T* output);
+
+        //! Gets the matrix by vector kernel.
+        /** Gets the matrix by vector kernel supported by the processor.
+         @return A pointer to the kernel or null.
+         */
+        static inline MatrixVector getMatrixVector() noexcept
+        {
+            return nullptr;
+        }
+
+        //! The type of the matrix by vectors kernels.
+        /** The kernels process the largest number of frames that fits their tiles and return this number. If accumulate is true, the result is added to the output vectors.
+         */
+        typedef ulong (*MatrixBlock)(const ulong colsize, const ulong rowsize, const ulong frames, const T** inputs, const T* matrix, T** outputs, const bool accumulate);
+
+        //! Gets the matrix by vectors kernel.
+        /** Gets the matrix by vectors kernel supported by the processor.
+         @return A pointer to the kernel or null.
+         */
+        static inline MatrixBlock getMatrixBlock() noexcept
+        {
+            return nullptr;
+        }
+    };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+    template <> class Simd<float>
+    {
+    public:
+        typedef void (*MatrixVector)(const ulong colsize, const ulong rowsize, const float* in, const float* matrix, float* output);
+        typedef ulong (*MatrixBlock)(const ulong colsize, const ulong rowsize, const ulong frames, const float** inputs, const float* matrix, float** outputs, const bool accumulate);
+
+#ifdef HOA_SIMD_X86
+    private:
+
+        HOA_SIMD_TARGET("sse2") static inline float sum(const __m128 vec) noexcept
+        {
+            const __m128 temp = _mm_add_ps(vec, _mm_movehl_ps(vec, vec));
+            return _mm_cvtss_f32(_mm_add_ss(temp, _mm_shuffle_ps(temp, temp, 1)));
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static inline float sum(const __m256 vec) noexcept
+        {
+            const __m128 temp = _mm_add_ps(_mm256_castps256_ps128(vec), _mm256_extractf128_ps(vec, 1));
+            return sum(temp);
+        }
+
+        HOA_SIMD_TARGET("sse2") static void mulSse2(const ulong colsize, const ulong rowsize, const float* in, const float* matrix, float* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(3);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const float* m0 = matrix;
+                const float* m1 = m0 + colsize;
+                const float* m2 = m1 + colsize;
+                const float* m3 = m2 + colsize;
+                __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps(), a2 = _mm_setzero_ps(), a3 = _mm_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 4ul)
+                {
+                    const __m128 x = _mm_loadu_ps(in + j);
+                    a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(m0 + j), x));
+                    a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(m1 + j), x));
+                    a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(m2 + j), x));
+                    a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(m3 + j), x));
+                }
+                float r0 = sum(a0), r1 = sum(a1), r2 = sum(a2), r3 = sum(a3);
+                for(; j < colsize; j++)
+                {
+                    r0 += m0[j] * in[j]; r1 += m1[j] * in[j]; r2 += m2[j] * in[j]; r3 += m3[j] * in[j];
+                }
+                output[i] = r0; output[i+1] = r1; output[i+2] = r2; output[i+3] = r3;
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m128 a0 = _mm_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 4ul)
+                {
+                    a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(matrix + j), _mm_loadu_ps(in + j)));
+                }
+                float r0 = sum(a0);
+                for(; j < colsize; j++)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static void mulAvx2(const ulong colsize, const ulong rowsize, const float* in, const float* matrix, float* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(7);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const float* m0 = matrix;
+                const float* m1 = m0 + colsize;
+                const float* m2 = m1 + colsize;
+                const float* m3 = m2 + colsize;
+                __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps(), a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 8ul)
+                {
+                    const __m256 x = _mm256_loadu_ps(in + j);
+                    a0 = _mm256_fmadd_ps(_mm256_loadu_ps(m0 + j), x, a0);
+                    a1 = _mm256_fmadd_ps(_mm256_loadu_ps(m1 + j), x, a1);
+                    a2 = _mm256_fmadd_ps(_mm256_loadu_ps(m2 + j), x, a2);
+                    a3 = _mm256_fmadd_ps(_mm256_loadu_ps(m3 + j), x, a3);
+                }
+                float r0 = sum(a0), r1 = sum(a1), r2 = sum(a2), r3 = sum(a3);
+                for(; j < colsize; j++)
+                {
+                    r0 += m0[j] * in[j]; r1 += m1[j] * in[j]; r2 += m2[j] * in[j]; r3 += m3[j] * in[j];
+                }
+                output[i] = r0; output[i+1] = r1; output[i+2] = r2; output[i+3] = r3;
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m256 a0 = _mm256_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 8ul)
+                {
+                    a0 = _mm256_fmadd_ps(_mm256_loadu_ps(matrix + j), _mm256_loadu_ps(in + j), a0);
+                }
+                float r0 = sum(a0);
+                for(; j < colsize; j++)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        HOA_SIMD_TARGET("avx512f") static void mulAvx512(const ulong colsize, const ulong rowsize, const float* in, const float* matrix, float* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(15);
+            const __mmask16 mask = __mmask16((1u << (colsize & 15ul)) - 1u);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const float* m0 = matrix;
+                const float* m1 = m0 + colsize;
+                const float* m2 = m1 + colsize;
+                const float* m3 = m2 + colsize;
+                __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps(), a2 = _mm512_setzero_ps(), a3 = _mm512_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 16ul)
+                {
+                    const __m512 x = _mm512_loadu_ps(in + j);
+                    a0 = _mm512_fmadd_ps(_mm512_loadu_ps(m0 + j), x, a0);
+                    a1 = _mm512_fmadd_ps(_mm512_loadu_ps(m1 + j), x, a1);
+                    a2 = _mm512_fmadd_ps(_mm512_loadu_ps(m2 + j), x, a2);
+                    a3 = _mm512_fmadd_ps(_mm512_loadu_ps(m3 + j), x, a3);
+                }
+                if(mask)
+                {
+                    const __m512 x = _mm512_maskz_loadu_ps(mask, in + j);
+                    a0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, m0 + j), x, a0);
+                    a1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, m1 + j), x, a1);
+                    a2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, m2 + j), x, a2);
+                    a3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, m3 + j), x, a3);
+                }
+                output[i]   = _mm512_reduce_add_ps(a0);
+                output[i+1] = _mm512_reduce_add_ps(a1);
+                output[i+2] = _mm512_reduce_add_ps(a2);
+                output[i+3] = _mm512_reduce_add_ps(a3);
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m512 a0 = _mm512_setzero_ps();
+                ulong j = 0ul;
+                for(; j < size; j += 16ul)
+                {
+                    a0 = _mm512_fmadd_ps(_mm512_loadu_ps(matrix + j), _mm512_loadu_ps(in + j), a0);
+                }
+                if(mask)
+                {
+                    a0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, matrix + j), _mm512_maskz_loadu_ps(mask, in + j), a0);
+                }
+                output[i] = _mm512_reduce_add_ps(a0);
+            }
+        }
+
+        HOA_SIMD_TARGET("sse2") static ulong mulBlockSse2(const ulong colsize, const ulong rowsize, const ulong frames, const float** inputs, const float* matrix, float** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(7);
+            for(ulong f = 0ul; f < size; f += 8ul)
+            {
+                const float* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const float* m1 = m0 + colsize;
+                    const float* m2 = m1 + colsize;
+                    const float* m3 = m2 + colsize;
+                    __m128 a00 = _mm_setzero_ps(), a01 = _mm_setzero_ps(), a10 = _mm_setzero_ps(), a11 = _mm_setzero_ps();
+                    __m128 a20 = _mm_setzero_ps(), a21 = _mm_setzero_ps(), a30 = _mm_setzero_ps(), a31 = _mm_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m128 x0 = _mm_loadu_ps(inputs[j] + f);
+                        const __m128 x1 = _mm_loadu_ps(inputs[j] + f + 4ul);
+                        const __m128 g0 = _mm_set1_ps(m0[j]), g1 = _mm_set1_ps(m1[j]), g2 = _mm_set1_ps(m2[j]), g3 = _mm_set1_ps(m3[j]);
+                        a00 = _mm_add_ps(a00, _mm_mul_ps(g0, x0)); a01 = _mm_add_ps(a01, _mm_mul_ps(g0, x1));
+                        a10 = _mm_add_ps(a10, _mm_mul_ps(g1, x0)); a11 = _mm_add_ps(a11, _mm_mul_ps(g1, x1));
+                        a20 = _mm_add_ps(a20, _mm_mul_ps(g2, x0)); a21 = _mm_add_ps(a21, _mm_mul_ps(g2, x1));
+                        a30 = _mm_add_ps(a30, _mm_mul_ps(g3, x0)); a31 = _mm_add_ps(a31, _mm_mul_ps(g3, x1));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm_add_ps(a00, _mm_loadu_ps(outputs[i] + f));   a01 = _mm_add_ps(a01, _mm_loadu_ps(outputs[i] + f + 4ul));
+                        a10 = _mm_add_ps(a10, _mm_loadu_ps(outputs[i+1] + f)); a11 = _mm_add_ps(a11, _mm_loadu_ps(outputs[i+1] + f + 4ul));
+                        a20 = _mm_add_ps(a20, _mm_loadu_ps(outputs[i+2] + f)); a21 = _mm_add_ps(a21, _mm_loadu_ps(outputs[i+2] + f + 4ul));
+                        a30 = _mm_add_ps(a30, _mm_loadu_ps(outputs[i+3] + f)); a31 = _mm_add_ps(a31, _mm_loadu_ps(outputs[i+3] + f + 4ul));
+                    }
+                    _mm_storeu_ps(outputs[i] + f, a00);   _mm_storeu_ps(outputs[i] + f + 4ul, a01);
+                    _mm_storeu_ps(outputs[i+1] + f, a10); _mm_storeu_ps(outputs[i+1] + f + 4ul, a11);
+                    _mm_storeu_ps(outputs[i+2] + f, a20); _mm_storeu_ps(outputs[i+2] + f + 4ul, a21);
+                    _mm_storeu_ps(outputs[i+3] + f, a30); _mm_storeu_ps(outputs[i+3] + f + 4ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m128 a00 = _mm_setzero_ps(), a01 = _mm_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m128 g0 = _mm_set1_ps(m0[j]);
+                        a00 = _mm_add_ps(a00, _mm_mul_ps(g0, _mm_loadu_ps(inputs[j] + f)));
+                        a01 = _mm_add_ps(a01, _mm_mul_ps(g0, _mm_loadu_ps(inputs[j] + f + 4ul)));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm_add_ps(a00, _mm_loadu_ps(outputs[i] + f)); a01 = _mm_add_ps(a01, _mm_loadu_ps(outputs[i] + f + 4ul));
+                    }
+                    _mm_storeu_ps(outputs[i] + f, a00); _mm_storeu_ps(outputs[i] + f + 4ul, a01);
+                }
+            }
+            return size;
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static ulong mulBlockAvx2(const ulong colsize, const ulong rowsize, const ulong frames, const float** inputs, const float* matrix, float** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(15);
+            for(ulong f = 0ul; f < size; f += 16ul)
+            {
+                const float* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const float* m1 = m0 + colsize;
+                    const float* m2 = m1 + colsize;
+                    const float* m3 = m2 + colsize;
+                    __m256 a00 = _mm256_setzero_ps(), a01 = _mm256_setzero_ps(), a10 = _mm256_setzero_ps(), a11 = _mm256_setzero_ps();
+                    __m256 a20 = _mm256_setzero_ps(), a21 = _mm256_setzero_ps(), a30 = _mm256_setzero_ps(), a31 = _mm256_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m256 x0 = _mm256_loadu_ps(inputs[j] + f);
+                        const __m256 x1 = _mm256_loadu_ps(inputs[j] + f + 8ul);
+                        const __m256 g0 = _mm256_set1_ps(m0[j]), g1 = _mm256_set1_ps(m1[j]), g2 = _mm256_set1_ps(m2[j]), g3 = _mm256_set1_ps(m3[j]);
+                        a00 = _mm256_fmadd_ps(g0, x0, a00); a01 = _mm256_fmadd_ps(g0, x1, a01);
+                        a10 = _mm256_fmadd_ps(g1, x0, a10); a11 = _mm256_fmadd_ps(g1, x1, a11);
+                        a20 = _mm256_fmadd_ps(g2, x0, a20); a21 = _mm256_fmadd_ps(g2, x1, a21);
+                        a30 = _mm256_fmadd_ps(g3, x0, a30); a31 = _mm256_fmadd_ps(g3, x1, a31);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm256_add_ps(a00, _mm256_loadu_ps(outputs[i] + f));   a01 = _mm256_add_ps(a01, _mm256_loadu_ps(outputs[i] + f + 8ul));
+                        a10 = _mm256_add_ps(a10, _mm256_loadu_ps(outputs[i+1] + f)); a11 = _mm256_add_ps(a11, _mm256_loadu_ps(outputs[i+1] + f + 8ul));
+                        a20 = _mm256_add_ps(a20, _mm256_loadu_ps(outputs[i+2] + f)); a21 = _mm256_add_ps(a21, _mm256_loadu_ps(outputs[i+2] + f + 8ul));
+                        a30 = _mm256_add_ps(a30, _mm256_loadu_ps(outputs[i+3] + f)); a31 = _mm256_add_ps(a31, _mm256_loadu_ps(outputs[i+3] + f + 8ul));
+                    }
+                    _mm256_storeu_ps(outputs[i] + f, a00);   _mm256_storeu_ps(outputs[i] + f + 8ul, a01);
+                    _mm256_storeu_ps(outputs[i+1] + f, a10); _mm256_storeu_ps(outputs[i+1] + f + 8ul, a11);
+                    _mm256_storeu_ps(outputs[i+2] + f, a20); _mm256_storeu_ps(outputs[i+2] + f + 8ul, a21);
+                    _mm256_storeu_ps(outputs[i+3] + f, a30); _mm256_storeu_ps(outputs[i+3] + f + 8ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m256 a00 = _mm256_setzero_ps(), a01 = _mm256_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m256 g0 = _mm256_set1_ps(m0[j]);
+                        a00 = _mm256_fmadd_ps(g0, _mm256_loadu_ps(inputs[j] + f), a00);
+                        a01 = _mm256_fmadd_ps(g0, _mm256_loadu_ps(inputs[j] + f + 8ul), a01);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm256_add_ps(a00, _mm256_loadu_ps(outputs[i] + f)); a01 = _mm256_add_ps(a01, _mm256_loadu_ps(outputs[i] + f + 8ul));
+                    }
+                    _mm256_storeu_ps(outputs[i] + f, a00); _mm256_storeu_ps(outputs[i] + f + 8ul, a01);
+                }
+            }
+            return size;
+        }
+
+        HOA_SIMD_TARGET("avx512f") static ulong mulBlockAvx512(const ulong colsize, const ulong rowsize, const ulong frames, const float** inputs, const float* matrix, float** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(31);
+            for(ulong f = 0ul; f < size; f += 32ul)
+            {
+                const float* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const float* m1 = m0 + colsize;
+                    const float* m2 = m1 + colsize;
+                    const float* m3 = m2 + colsize;
+                    __m512 a00 = _mm512_setzero_ps(), a01 = _mm512_setzero_ps(), a10 = _mm512_setzero_ps(), a11 = _mm512_setzero_ps();
+                    __m512 a20 = _mm512_setzero_ps(), a21 = _mm512_setzero_ps(), a30 = _mm512_setzero_ps(), a31 = _mm512_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m512 x0 = _mm512_loadu_ps(inputs[j] + f);
+                        const __m512 x1 = _mm512_loadu_ps(inputs[j] + f + 16ul);
+                        const __m512 g0 = _mm512_set1_ps(m0[j]), g1 = _mm512_set1_ps(m1[j]), g2 = _mm512_set1_ps(m2[j]), g3 = _mm512_set1_ps(m3[j]);
+                        a00 = _mm512_fmadd_ps(g0, x0, a00); a01 = _mm512_fmadd_ps(g0, x1, a01);
+                        a10 = _mm512_fmadd_ps(g1, x0, a10); a11 = _mm512_fmadd_ps(g1, x1, a11);
+                        a20 = _mm512_fmadd_ps(g2, x0, a20); a21 = _mm512_fmadd_ps(g2, x1, a21);
+                        a30 = _mm512_fmadd_ps(g3, x0, a30); a31 = _mm512_fmadd_ps(g3, x1, a31);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm512_add_ps(a00, _mm512_loadu_ps(outputs[i] + f));   a01 = _mm512_add_ps(a01, _mm512_loadu_ps(outputs[i] + f + 16ul));
+                        a10 = _mm512_add_ps(a10, _mm512_loadu_ps(outputs[i+1] + f)); a11 = _mm512_add_ps(a11, _mm512_loadu_ps(outputs[i+1] + f + 16ul));
+                        a20 = _mm512_add_ps(a20, _mm512_loadu_ps(outputs[i+2] + f)); a21 = _mm512_add_ps(a21, _mm512_loadu_ps(outputs[i+2] + f + 16ul));
+                        a30 = _mm512_add_ps(a30, _mm512_loadu_ps(outputs[i+3] + f)); a31 = _mm512_add_ps(a31, _mm512_loadu_ps(outputs[i+3] + f + 16ul));
+                    }
+                    _mm512_storeu_ps(outputs[i] + f, a00);   _mm512_storeu_ps(outputs[i] + f + 16ul, a01);
+                    _mm512_storeu_ps(outputs[i+1] + f, a10); _mm512_storeu_ps(outputs[i+1] + f + 16ul, a11);
+                    _mm512_storeu_ps(outputs[i+2] + f, a20); _mm512_storeu_ps(outputs[i+2] + f + 16ul, a21);
+                    _mm512_storeu_ps(outputs[i+3] + f, a30); _mm512_storeu_ps(outputs[i+3] + f + 16ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m512 a00 = _mm512_setzero_ps(), a01 = _mm512_setzero_ps();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m512 g0 = _mm512_set1_ps(m0[j]);
+                        a00 = _mm512_fmadd_ps(g0, _mm512_loadu_ps(inputs[j] + f), a00);
+                        a01 = _mm512_fmadd_ps(g0, _mm512_loadu_ps(inputs[j] + f + 16ul), a01);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm512_add_ps(a00, _mm512_loadu_ps(outputs[i] + f)); a01 = _mm512_add_ps(a01, _mm512_loadu_ps(outputs[i] + f + 16ul));
+                    }
+                    _mm512_storeu_ps(outputs[i] + f, a00); _mm512_storeu_ps(outputs[i] + f + 16ul, a01);
+                }
+            }
+            return size;
+        }
+#elif defined(HOA_SIMD_NEON)
+    private:
+
+        static inline float sum(const float32x4_t vec) noexcept
+        {
+#ifdef __aarch64__
+            return vaddvq_f32(vec);
+#else
+            const float32x2_t temp = vadd_f32(vget_low_f32(vec), vget_high_f32(vec));
+            return vget_lane_f32(vpadd_f32(temp, temp), 0);
+#endif
+        }
+
+        static void mulNeon(const ulong colsize, const ulong rowsize, const float* in, const float* matrix, float* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(3);
+            for(ulong i = 0ul; i < rowsize; i++, matrix += colsize)
+            {
+                float32x4_t a0 = vdupq_n_f32(0.f);
+                ulong j = 0ul;
+                for(; j < size; j += 4ul)
+                {
+                    a0 = vmlaq_f32(a0, vld1q_f32(matrix + j), vld1q_f32(in + j));
+                }
+                float r0 = sum(a0);
+                for(; j < colsize; j++)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        static ulong mulBlockNeon(const ulong colsize, const ulong rowsize, const ulong frames, const float** inputs, const float* matrix, float** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(7);
+            for(ulong f = 0ul; f < size; f += 8ul)
+            {
+                const float* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const float* m1 = m0 + colsize;
+                    const float* m2 = m1 + colsize;
+                    const float* m3 = m2 + colsize;
+                    float32x4_t a00 = vdupq_n_f32(0.f), a01 = vdupq_n_f32(0.f), a10 = vdupq_n_f32(0.f), a11 = vdupq_n_f32(0.f);
+                    float32x4_t a20 = vdupq_n_f32(0.f), a21 = vdupq_n_f32(0.f), a30 = vdupq_n_f32(0.f), a31 = vdupq_n_f32(0.f);
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const float32x4_t x0 = vld1q_f32(inputs[j] + f);
+                        const float32x4_t x1 = vld1q_f32(inputs[j] + f + 4ul);
+                        const float32x4_t g0 = vdupq_n_f32(m0[j]), g1 = vdupq_n_f32(m1[j]), g2 = vdupq_n_f32(m2[j]), g3 = vdupq_n_f32(m3[j]);
+                        a00 = vmlaq_f32(a00, g0, x0); a01 = vmlaq_f32(a01, g0, x1);
+                        a10 = vmlaq_f32(a10, g1, x0); a11 = vmlaq_f32(a11, g1, x1);
+                        a20 = vmlaq_f32(a20, g2, x0); a21 = vmlaq_f32(a21, g2, x1);
+                        a30 = vmlaq_f32(a30, g3, x0); a31 = vmlaq_f32(a31, g3, x1);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = vaddq_f32(a00, vld1q_f32(outputs[i] + f));   a01 = vaddq_f32(a01, vld1q_f32(outputs[i] + f + 4ul));
+                        a10 = vaddq_f32(a10, vld1q_f32(outputs[i+1] + f)); a11 = vaddq_f32(a11, vld1q_f32(outputs[i+1] + f + 4ul));
+                        a20 = vaddq_f32(a20, vld1q_f32(outputs[i+2] + f)); a21 = vaddq_f32(a21, vld1q_f32(outputs[i+2] + f + 4ul));
+                        a30 = vaddq_f32(a30, vld1q_f32(outputs[i+3] + f)); a31 = vaddq_f32(a31, vld1q_f32(outputs[i+3] + f + 4ul));
+                    }
+                    vst1q_f32(outputs[i] + f, a00);   vst1q_f32(outputs[i] + f + 4ul, a01);
+                    vst1q_f32(outputs[i+1] + f, a10); vst1q_f32(outputs[i+1] + f + 4ul, a11);
+                    vst1q_f32(outputs[i+2] + f, a20); vst1q_f32(outputs[i+2] + f + 4ul, a21);
+                    vst1q_f32(outputs[i+3] + f, a30); vst1q_f32(outputs[i+3] + f + 4ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    float32x4_t a00 = vdupq_n_f32(0.f), a01 = vdupq_n_f32(0.f);
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const float32x4_t g0 = vdupq_n_f32(m0[j]);
+                        a00 = vmlaq_f32(a00, g0, vld1q_f32(inputs[j] + f));
+                        a01 = vmlaq_f32(a01, g0, vld1q_f32(inputs[j] + f + 4ul));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = vaddq_f32(a00, vld1q_f32(outputs[i] + f)); a01 = vaddq_f32(a01, vld1q_f32(outputs[i] + f + 4ul));
+                    }
+                    vst1q_f32(outputs[i] + f, a00); vst1q_f32(outputs[i] + f + 4ul, a01);
+                }
+            }
+            return size;
+        }
+#endif
+    public:
+
+        static inline MatrixVector getMatrixVector() noexcept
+        {
+#ifdef HOA_SIMD_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f"))
+            {
+                return &mulAvx512;
+            }
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return &mulAvx2;
+            }
+            if(__builtin_cpu_supports("sse2"))
+            {
+                return &mulSse2;
+            }
+            return nullptr;
+#elif defined(HOA_SIMD_NEON)
+            return &mulNeon;
+#else
+            return nullptr;
+#endif
+        }
+
+        static inline MatrixBlock getMatrixBlock() noexcept
+        {
+#ifdef HOA_SIMD_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f"))
+            {
+                return &mulBlockAvx512;
+            }
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return &mulBlockAvx2;
+            }
+            if(__builtin_cpu_supports("sse2"))
+            {
+                return &mulBlockSse2;
+            }
+            return nullptr;
+#elif defined(HOA_SIMD_NEON)
+            return &mulBlockNeon;
+#else
+            return nullptr;
+#endif
+        }
+    };
+
+    template <> class Simd<double>
+    {
+    public:
+        typedef void (*MatrixVector)(const ulong colsize, const ulong rowsize, const double* in, const double* matrix, double* output);
+        typedef ulong (*MatrixBlock)(const ulong colsize, const ulong rowsize, const ulong frames, const double** inputs, const double* matrix, double** outputs, const bool accumulate);
+
+#ifdef HOA_SIMD_X86
+    private:
+
+        HOA_SIMD_TARGET("sse2") static inline double sum(const __m128d vec) noexcept
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(vec, _mm_unpackhi_pd(vec, vec)));
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static inline double sum(const __m256d vec) noexcept
+        {
+            return sum(_mm_add_pd(_mm256_castpd256_pd128(vec), _mm256_extractf128_pd(vec, 1)));
+        }
+
+        HOA_SIMD_TARGET("sse2") static void mulSse2(const ulong colsize, const ulong rowsize, const double* in, const double* matrix, double* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(1);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const double* m0 = matrix;
+                const double* m1 = m0 + colsize;
+                const double* m2 = m1 + colsize;
+                const double* m3 = m2 + colsize;
+                __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd(), a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 2ul)
+                {
+                    const __m128d x = _mm_loadu_pd(in + j);
+                    a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(m0 + j), x));
+                    a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(m1 + j), x));
+                    a2 = _mm_add_pd(a2, _mm_mul_pd(_mm_loadu_pd(m2 + j), x));
+                    a3 = _mm_add_pd(a3, _mm_mul_pd(_mm_loadu_pd(m3 + j), x));
+                }
+                double r0 = sum(a0), r1 = sum(a1), r2 = sum(a2), r3 = sum(a3);
+                if(j < colsize)
+                {
+                    r0 += m0[j] * in[j]; r1 += m1[j] * in[j]; r2 += m2[j] * in[j]; r3 += m3[j] * in[j];
+                }
+                output[i] = r0; output[i+1] = r1; output[i+2] = r2; output[i+3] = r3;
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m128d a0 = _mm_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 2ul)
+                {
+                    a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(matrix + j), _mm_loadu_pd(in + j)));
+                }
+                double r0 = sum(a0);
+                if(j < colsize)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static void mulAvx2(const ulong colsize, const ulong rowsize, const double* in, const double* matrix, double* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(3);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const double* m0 = matrix;
+                const double* m1 = m0 + colsize;
+                const double* m2 = m1 + colsize;
+                const double* m3 = m2 + colsize;
+                __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd(), a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 4ul)
+                {
+                    const __m256d x = _mm256_loadu_pd(in + j);
+                    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(m0 + j), x, a0);
+                    a1 = _mm256_fmadd_pd(_mm256_loadu_pd(m1 + j), x, a1);
+                    a2 = _mm256_fmadd_pd(_mm256_loadu_pd(m2 + j), x, a2);
+                    a3 = _mm256_fmadd_pd(_mm256_loadu_pd(m3 + j), x, a3);
+                }
+                double r0 = sum(a0), r1 = sum(a1), r2 = sum(a2), r3 = sum(a3);
+                for(; j < colsize; j++)
+                {
+                    r0 += m0[j] * in[j]; r1 += m1[j] * in[j]; r2 += m2[j] * in[j]; r3 += m3[j] * in[j];
+                }
+                output[i] = r0; output[i+1] = r1; output[i+2] = r2; output[i+3] = r3;
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m256d a0 = _mm256_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 4ul)
+                {
+                    a0 = _mm256_fmadd_pd(_mm256_loadu_pd(matrix + j), _mm256_loadu_pd(in + j), a0);
+                }
+                double r0 = sum(a0);
+                for(; j < colsize; j++)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        HOA_SIMD_TARGET("avx512f") static void mulAvx512(const ulong colsize, const ulong rowsize, const double* in, const double* matrix, double* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(7);
+            const __mmask8 mask = __mmask8((1u << (colsize & 7ul)) - 1u);
+            ulong i = 0ul;
+            for(; i + 4ul <= rowsize; i += 4ul, matrix += colsize * 4ul)
+            {
+                const double* m0 = matrix;
+                const double* m1 = m0 + colsize;
+                const double* m2 = m1 + colsize;
+                const double* m3 = m2 + colsize;
+                __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd(), a2 = _mm512_setzero_pd(), a3 = _mm512_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 8ul)
+                {
+                    const __m512d x = _mm512_loadu_pd(in + j);
+                    a0 = _mm512_fmadd_pd(_mm512_loadu_pd(m0 + j), x, a0);
+                    a1 = _mm512_fmadd_pd(_mm512_loadu_pd(m1 + j), x, a1);
+                    a2 = _mm512_fmadd_pd(_mm512_loadu_pd(m2 + j), x, a2);
+                    a3 = _mm512_fmadd_pd(_mm512_loadu_pd(m3 + j), x, a3);
+                }
+                if(mask)
+                {
+                    const __m512d x = _mm512_maskz_loadu_pd(mask, in + j);
+                    a0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, m0 + j), x, a0);
+                    a1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, m1 + j), x, a1);
+                    a2 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, m2 + j), x, a2);
+                    a3 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, m3 + j), x, a3);
+                }
+                output[i]   = _mm512_reduce_add_pd(a0);
+                output[i+1] = _mm512_reduce_add_pd(a1);
+                output[i+2] = _mm512_reduce_add_pd(a2);
+                output[i+3] = _mm512_reduce_add_pd(a3);
+            }
+            for(; i < rowsize; i++, matrix += colsize)
+            {
+                __m512d a0 = _mm512_setzero_pd();
+                ulong j = 0ul;
+                for(; j < size; j += 8ul)
+                {
+                    a0 = _mm512_fmadd_pd(_mm512_loadu_pd(matrix + j), _mm512_loadu_pd(in + j), a0);
+                }
+                if(mask)
+                {
+                    a0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, matrix + j), _mm512_maskz_loadu_pd(mask, in + j), a0);
+                }
+                output[i] = _mm512_reduce_add_pd(a0);
+            }
+        }
+
+        HOA_SIMD_TARGET("sse2") static ulong mulBlockSse2(const ulong colsize, const ulong rowsize, const ulong frames, const double** inputs, const double* matrix, double** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(3);
+            for(ulong f = 0ul; f < size; f += 4ul)
+            {
+                const double* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const double* m1 = m0 + colsize;
+                    const double* m2 = m1 + colsize;
+                    const double* m3 = m2 + colsize;
+                    __m128d a00 = _mm_setzero_pd(), a01 = _mm_setzero_pd(), a10 = _mm_setzero_pd(), a11 = _mm_setzero_pd();
+                    __m128d a20 = _mm_setzero_pd(), a21 = _mm_setzero_pd(), a30 = _mm_setzero_pd(), a31 = _mm_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m128d x0 = _mm_loadu_pd(inputs[j] + f);
+                        const __m128d x1 = _mm_loadu_pd(inputs[j] + f + 2ul);
+                        const __m128d g0 = _mm_set1_pd(m0[j]), g1 = _mm_set1_pd(m1[j]), g2 = _mm_set1_pd(m2[j]), g3 = _mm_set1_pd(m3[j]);
+                        a00 = _mm_add_pd(a00, _mm_mul_pd(g0, x0)); a01 = _mm_add_pd(a01, _mm_mul_pd(g0, x1));
+                        a10 = _mm_add_pd(a10, _mm_mul_pd(g1, x0)); a11 = _mm_add_pd(a11, _mm_mul_pd(g1, x1));
+                        a20 = _mm_add_pd(a20, _mm_mul_pd(g2, x0)); a21 = _mm_add_pd(a21, _mm_mul_pd(g2, x1));
+                        a30 = _mm_add_pd(a30, _mm_mul_pd(g3, x0)); a31 = _mm_add_pd(a31, _mm_mul_pd(g3, x1));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm_add_pd(a00, _mm_loadu_pd(outputs[i] + f));   a01 = _mm_add_pd(a01, _mm_loadu_pd(outputs[i] + f + 2ul));
+                        a10 = _mm_add_pd(a10, _mm_loadu_pd(outputs[i+1] + f)); a11 = _mm_add_pd(a11, _mm_loadu_pd(outputs[i+1] + f + 2ul));
+                        a20 = _mm_add_pd(a20, _mm_loadu_pd(outputs[i+2] + f)); a21 = _mm_add_pd(a21, _mm_loadu_pd(outputs[i+2] + f + 2ul));
+                        a30 = _mm_add_pd(a30, _mm_loadu_pd(outputs[i+3] + f)); a31 = _mm_add_pd(a31, _mm_loadu_pd(outputs[i+3] + f + 2ul));
+                    }
+                    _mm_storeu_pd(outputs[i] + f, a00);   _mm_storeu_pd(outputs[i] + f + 2ul, a01);
+                    _mm_storeu_pd(outputs[i+1] + f, a10); _mm_storeu_pd(outputs[i+1] + f + 2ul, a11);
+                    _mm_storeu_pd(outputs[i+2] + f, a20); _mm_storeu_pd(outputs[i+2] + f + 2ul, a21);
+                    _mm_storeu_pd(outputs[i+3] + f, a30); _mm_storeu_pd(outputs[i+3] + f + 2ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m128d a00 = _mm_setzero_pd(), a01 = _mm_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m128d g0 = _mm_set1_pd(m0[j]);
+                        a00 = _mm_add_pd(a00, _mm_mul_pd(g0, _mm_loadu_pd(inputs[j] + f)));
+                        a01 = _mm_add_pd(a01, _mm_mul_pd(g0, _mm_loadu_pd(inputs[j] + f + 2ul)));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm_add_pd(a00, _mm_loadu_pd(outputs[i] + f)); a01 = _mm_add_pd(a01, _mm_loadu_pd(outputs[i] + f + 2ul));
+                    }
+                    _mm_storeu_pd(outputs[i] + f, a00); _mm_storeu_pd(outputs[i] + f + 2ul, a01);
+                }
+            }
+            return size;
+        }
+
+        HOA_SIMD_TARGET("avx2,fma") static ulong mulBlockAvx2(const ulong colsize, const ulong rowsize, const ulong frames, const double** inputs, const double* matrix, double** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(7);
+            for(ulong f = 0ul; f < size; f += 8ul)
+            {
+                const double* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const double* m1 = m0 + colsize;
+                    const double* m2 = m1 + colsize;
+                    const double* m3 = m2 + colsize;
+                    __m256d a00 = _mm256_setzero_pd(), a01 = _mm256_setzero_pd(), a10 = _mm256_setzero_pd(), a11 = _mm256_setzero_pd();
+                    __m256d a20 = _mm256_setzero_pd(), a21 = _mm256_setzero_pd(), a30 = _mm256_setzero_pd(), a31 = _mm256_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m256d x0 = _mm256_loadu_pd(inputs[j] + f);
+                        const __m256d x1 = _mm256_loadu_pd(inputs[j] + f + 4ul);
+                        const __m256d g0 = _mm256_set1_pd(m0[j]), g1 = _mm256_set1_pd(m1[j]), g2 = _mm256_set1_pd(m2[j]), g3 = _mm256_set1_pd(m3[j]);
+                        a00 = _mm256_fmadd_pd(g0, x0, a00); a01 = _mm256_fmadd_pd(g0, x1, a01);
+                        a10 = _mm256_fmadd_pd(g1, x0, a10); a11 = _mm256_fmadd_pd(g1, x1, a11);
+                        a20 = _mm256_fmadd_pd(g2, x0, a20); a21 = _mm256_fmadd_pd(g2, x1, a21);
+                        a30 = _mm256_fmadd_pd(g3, x0, a30); a31 = _mm256_fmadd_pd(g3, x1, a31);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm256_add_pd(a00, _mm256_loadu_pd(outputs[i] + f));   a01 = _mm256_add_pd(a01, _mm256_loadu_pd(outputs[i] + f + 4ul));
+                        a10 = _mm256_add_pd(a10, _mm256_loadu_pd(outputs[i+1] + f)); a11 = _mm256_add_pd(a11, _mm256_loadu_pd(outputs[i+1] + f + 4ul));
+                        a20 = _mm256_add_pd(a20, _mm256_loadu_pd(outputs[i+2] + f)); a21 = _mm256_add_pd(a21, _mm256_loadu_pd(outputs[i+2] + f + 4ul));
+                        a30 = _mm256_add_pd(a30, _mm256_loadu_pd(outputs[i+3] + f)); a31 = _mm256_add_pd(a31, _mm256_loadu_pd(outputs[i+3] + f + 4ul));
+                    }
+                    _mm256_storeu_pd(outputs[i] + f, a00);   _mm256_storeu_pd(outputs[i] + f + 4ul, a01);
+                    _mm256_storeu_pd(outputs[i+1] + f, a10); _mm256_storeu_pd(outputs[i+1] + f + 4ul, a11);
+                    _mm256_storeu_pd(outputs[i+2] + f, a20); _mm256_storeu_pd(outputs[i+2] + f + 4ul, a21);
+                    _mm256_storeu_pd(outputs[i+3] + f, a30); _mm256_storeu_pd(outputs[i+3] + f + 4ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m256d a00 = _mm256_setzero_pd(), a01 = _mm256_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m256d g0 = _mm256_set1_pd(m0[j]);
+                        a00 = _mm256_fmadd_pd(g0, _mm256_loadu_pd(inputs[j] + f), a00);
+                        a01 = _mm256_fmadd_pd(g0, _mm256_loadu_pd(inputs[j] + f + 4ul), a01);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm256_add_pd(a00, _mm256_loadu_pd(outputs[i] + f)); a01 = _mm256_add_pd(a01, _mm256_loadu_pd(outputs[i] + f + 4ul));
+                    }
+                    _mm256_storeu_pd(outputs[i] + f, a00); _mm256_storeu_pd(outputs[i] + f + 4ul, a01);
+                }
+            }
+            return size;
+        }
+
+        HOA_SIMD_TARGET("avx512f") static ulong mulBlockAvx512(const ulong colsize, const ulong rowsize, const ulong frames, const double** inputs, const double* matrix, double** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(15);
+            for(ulong f = 0ul; f < size; f += 16ul)
+            {
+                const double* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const double* m1 = m0 + colsize;
+                    const double* m2 = m1 + colsize;
+                    const double* m3 = m2 + colsize;
+                    __m512d a00 = _mm512_setzero_pd(), a01 = _mm512_setzero_pd(), a10 = _mm512_setzero_pd(), a11 = _mm512_setzero_pd();
+                    __m512d a20 = _mm512_setzero_pd(), a21 = _mm512_setzero_pd(), a30 = _mm512_setzero_pd(), a31 = _mm512_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m512d x0 = _mm512_loadu_pd(inputs[j] + f);
+                        const __m512d x1 = _mm512_loadu_pd(inputs[j] + f + 8ul);
+                        const __m512d g0 = _mm512_set1_pd(m0[j]), g1 = _mm512_set1_pd(m1[j]), g2 = _mm512_set1_pd(m2[j]), g3 = _mm512_set1_pd(m3[j]);
+                        a00 = _mm512_fmadd_pd(g0, x0, a00); a01 = _mm512_fmadd_pd(g0, x1, a01);
+                        a10 = _mm512_fmadd_pd(g1, x0, a10); a11 = _mm512_fmadd_pd(g1, x1, a11);
+                        a20 = _mm512_fmadd_pd(g2, x0, a20); a21 = _mm512_fmadd_pd(g2, x1, a21);
+                        a30 = _mm512_fmadd_pd(g3, x0, a30); a31 = _mm512_fmadd_pd(g3, x1, a31);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm512_add_pd(a00, _mm512_loadu_pd(outputs[i] + f));   a01 = _mm512_add_pd(a01, _mm512_loadu_pd(outputs[i] + f + 8ul));
+                        a10 = _mm512_add_pd(a10, _mm512_loadu_pd(outputs[i+1] + f)); a11 = _mm512_add_pd(a11, _mm512_loadu_pd(outputs[i+1] + f + 8ul));
+                        a20 = _mm512_add_pd(a20, _mm512_loadu_pd(outputs[i+2] + f)); a21 = _mm512_add_pd(a21, _mm512_loadu_pd(outputs[i+2] + f + 8ul));
+                        a30 = _mm512_add_pd(a30, _mm512_loadu_pd(outputs[i+3] + f)); a31 = _mm512_add_pd(a31, _mm512_loadu_pd(outputs[i+3] + f + 8ul));
+                    }
+                    _mm512_storeu_pd(outputs[i] + f, a00);   _mm512_storeu_pd(outputs[i] + f + 8ul, a01);
+                    _mm512_storeu_pd(outputs[i+1] + f, a10); _mm512_storeu_pd(outputs[i+1] + f + 8ul, a11);
+                    _mm512_storeu_pd(outputs[i+2] + f, a20); _mm512_storeu_pd(outputs[i+2] + f + 8ul, a21);
+                    _mm512_storeu_pd(outputs[i+3] + f, a30); _mm512_storeu_pd(outputs[i+3] + f + 8ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    __m512d a00 = _mm512_setzero_pd(), a01 = _mm512_setzero_pd();
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const __m512d g0 = _mm512_set1_pd(m0[j]);
+                        a00 = _mm512_fmadd_pd(g0, _mm512_loadu_pd(inputs[j] + f), a00);
+                        a01 = _mm512_fmadd_pd(g0, _mm512_loadu_pd(inputs[j] + f + 8ul), a01);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = _mm512_add_pd(a00, _mm512_loadu_pd(outputs[i] + f)); a01 = _mm512_add_pd(a01, _mm512_loadu_pd(outputs[i] + f + 8ul));
+                    }
+                    _mm512_storeu_pd(outputs[i] + f, a00); _mm512_storeu_pd(outputs[i] + f + 8ul, a01);
+                }
+            }
+            return size;
+        }
+#elif defined(HOA_SIMD_NEON) && defined(__aarch64__)
+    private:
+
+        static void mulNeon(const ulong colsize, const ulong rowsize, const double* in, const double* matrix, double* output) noexcept
+        {
+            const ulong size = colsize & ~ulong(1);
+            for(ulong i = 0ul; i < rowsize; i++, matrix += colsize)
+            {
+                float64x2_t a0 = vdupq_n_f64(0.);
+                ulong j = 0ul;
+                for(; j < size; j += 2ul)
+                {
+                    a0 = vfmaq_f64(a0, vld1q_f64(matrix + j), vld1q_f64(in + j));
+                }
+                double r0 = vaddvq_f64(a0);
+                if(j < colsize)
+                {
+                    r0 += matrix[j] * in[j];
+                }
+                output[i] = r0;
+            }
+        }
+
+        static ulong mulBlockNeon(const ulong colsize, const ulong rowsize, const ulong frames, const double** inputs, const double* matrix, double** outputs, const bool accumulate) noexcept
+        {
+            const ulong size = frames & ~ulong(3);
+            for(ulong f = 0ul; f < size; f += 4ul)
+            {
+                const double* m0 = matrix;
+                ulong i = 0ul;
+                for(; i + 4ul <= rowsize; i += 4ul, m0 += colsize * 4ul)
+                {
+                    const double* m1 = m0 + colsize;
+                    const double* m2 = m1 + colsize;
+                    const double* m3 = m2 + colsize;
+                    float64x2_t a00 = vdupq_n_f64(0.), a01 = vdupq_n_f64(0.), a10 = vdupq_n_f64(0.), a11 = vdupq_n_f64(0.);
+                    float64x2_t a20 = vdupq_n_f64(0.), a21 = vdupq_n_f64(0.), a30 = vdupq_n_f64(0.), a31 = vdupq_n_f64(0.);
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const float64x2_t x0 = vld1q_f64(inputs[j] + f);
+                        const float64x2_t x1 = vld1q_f64(inputs[j] + f + 2ul);
+                        const float64x2_t g0 = vdupq_n_f64(m0[j]), g1 = vdupq_n_f64(m1[j]), g2 = vdupq_n_f64(m2[j]), g3 = vdupq_n_f64(m3[j]);
+                        a00 = vfmaq_f64(a00, g0, x0); a01 = vfmaq_f64(a01, g0, x1);
+                        a10 = vfmaq_f64(a10, g1, x0); a11 = vfmaq_f64(a11, g1, x1);
+                        a20 = vfmaq_f64(a20, g2, x0); a21 = vfmaq_f64(a21, g2, x1);
+                        a30 = vfmaq_f64(a30, g3, x0); a31 = vfmaq_f64(a31, g3, x1);
+                    }
+                    if(accumulate)
+                    {
+                        a00 = vaddq_f64(a00, vld1q_f64(outputs[i] + f));   a01 = vaddq_f64(a01, vld1q_f64(outputs[i] + f + 2ul));
+                        a10 = vaddq_f64(a10, vld1q_f64(outputs[i+1] + f)); a11 = vaddq_f64(a11, vld1q_f64(outputs[i+1] + f + 2ul));
+                        a20 = vaddq_f64(a20, vld1q_f64(outputs[i+2] + f)); a21 = vaddq_f64(a21, vld1q_f64(outputs[i+2] + f + 2ul));
+                        a30 = vaddq_f64(a30, vld1q_f64(outputs[i+3] + f)); a31 = vaddq_f64(a31, vld1q_f64(outputs[i+3] + f + 2ul));
+                    }
+                    vst1q_f64(outputs[i] + f, a00);   vst1q_f64(outputs[i] + f + 2ul, a01);
+                    vst1q_f64(outputs[i+1] + f, a10); vst1q_f64(outputs[i+1] + f + 2ul, a11);
+                    vst1q_f64(outputs[i+2] + f, a20); vst1q_f64(outputs[i+2] + f + 2ul, a21);
+                    vst1q_f64(outputs[i+3] + f, a30); vst1q_f64(outputs[i+3] + f + 2ul, a31);
+                }
+                for(; i < rowsize; i++, m0 += colsize)
+                {
+                    float64x2_t a00 = vdupq_n_f64(0.), a01 = vdupq_n_f64(0.);
+                    for(ulong j = 0ul; j < colsize; j++)
+                    {
+                        const float64x2_t g0 = vdupq_n_f64(m0[j]);
+                        a00 = vfmaq_f64(a00, g0, vld1q_f64(inputs[j] + f));
+                        a01 = vfmaq_f64(a01, g0, vld1q_f64(inputs[j] + f + 2ul));
+                    }
+                    if(accumulate)
+                    {
+                        a00 = vaddq_f64(a00, vld1q_f64(outputs[i] + f)); a01 = vaddq_f64(a01, vld1q_f64(outputs[i] + f + 2ul));
+                    }
+                    vst1q_f64(outputs[i] + f, a00); vst1q_f64(outputs[i] + f + 2ul, a01);
+                }
+            }
+            return size;
+        }
+#endif
+    public:
+
+        static inline MatrixVector getMatrixVector() noexcept
+        {
+#ifdef HOA_SIMD_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f"))
+            {
+                return &mulAvx512;
+            }
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return &mulAvx2;
+            }
+            if(__builtin_cpu_supports("sse2"))
+            {
+                return &mulSse2;
+            }
+            return nullptr;
+#elif defined(HOA_SIMD_NEON) && defined(__aarch64__)
+            return &mulNeon;
+#else
+            return nullptr;
+#endif
+        }
+
+        static inline MatrixBlock getMatrixBlock() noexcept
+        {
+#ifdef HOA_SIMD_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx512f"))
+            {
+                return &mulBlockAvx512;
+            }
+            if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return &mulBlockAvx2;
+            }
+            if(__builtin_cpu_supports("sse2"))
+            {
+                return &mulBlockSse2;
+            }
+            return nullptr;
+#elif defined(HOA_SIMD_NEON) && defined(__aarch64__)
+            return &mulBlockNeon;
+#else
+            return nullptr;
+#endif
+        }
+    };
+
+#endif
+}
+
+#endif
@@ -41,6 +41,14 @@ namespace hoa
          */
         virtual void process(const T* inputs, T* outputs) noexcept = 0;
 
+        //! This method compute the energy and the velocity vectors.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the channels and the minimum size must be the number of channels. The outputs array contains the vectors of the cartesian coordinates and the minimum size must be 4 for 2d and 6 for 3d. The coordinates arrangement in the outputs array is the same as for the sample by sample processing.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
         //! This method computes the velocity vector.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and contains the channels samples and the minimum size must be the number of channels. The outputs array contains the vectors cartesian coordinates and the minimum size must be 2 for 2d and 3 for 3d. The coordinates arrangement in the outputs array is velocity abscissa and velocity ordinate (and velocity height).
          @param     inputs   The inputs array.
@@ -64,6 +72,7 @@ namespace hoa
         T* m_channels_square;
         T* m_channels_abscissa;
         T* m_channels_ordinate;
+        T* m_vector;
     public:
 
         //! The vector constructor.
@@ -75,6 +84,7 @@ namespace hoa
             m_channels_square   = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
             m_channels_abscissa = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
             m_channels_ordinate = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_vector            = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() + 4);
         }
 
         //! The vector destructor.
@@ -85,6 +95,7 @@ namespace hoa
             Signal<T>::free(m_channels_square);
             Signal<T>::free(m_channels_abscissa);
             Signal<T>::free(m_channels_ordinate);
+            Signal<T>::free(m_vector);
         }
 
         //! This method pre-computes the necessary values to process.
@@ -110,6 +121,29 @@ namespace hoa
             processEnergy(inputs, outputs+2);
         }
 
+        //! This method compute the energy and the velocity vectors.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the channels and the minimum size must be the number of channels. The outputs array contains the vectors of the cartesian coordinates and the minimum size must be 4.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong i = 0; i < frames; i++)
+            {
+                for(ulong j = 0; j < size; j++)
+                {
+                    m_vector[j] = inputs[j][i];
+                }
+                process(m_vector, m_vector + size);
+                for(ulong j = 0; j < 4ul; j++)
+                {
+                    outputs[j][i] = m_vector[size + j];
+                }
+            }
+        }
+
         //! This method computes the velocity vector.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and contains the channels samples and the minimum size must be the number of channels. The outputs array contains the vectors cartesian coordinates and the minimum size must be 2. The coordinates arrangement in the outputs array is velocity abscissa and velocity ordinate.
          @param     inputs   The inputs array.
@@ -168,6 +202,7 @@ namespace hoa
         T* m_channels_abscissa;
         T* m_channels_ordinate;
         T* m_channels_height;
+        T* m_vector;
     public:
 
         //! The vector constructor.
@@ -180,6 +215,7 @@ namespace hoa
             m_channels_abscissa = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
             m_channels_ordinate = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
             m_channels_height   = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_vector            = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() + 6);
         }
 
         //! The vector destructor.
@@ -191,6 +227,7 @@ namespace hoa
             Signal<T>::free(m_channels_abscissa);
             Signal<T>::free(m_channels_ordinate);
             Signal<T>::free(m_channels_height);
+            Signal<T>::free(m_vector);
         }
 
         //! This method pre-computes the necessary values to process.
@@ -217,6 +254,29 @@ namespace hoa
             processEnergy(inputs, outputs+3);
         }
 
+        //! This method compute the energy and the velocity vectors.
+        /**	You should use this method for not-in-place processing and vector by vector. The inputs array contains the vectors of the channels and the minimum size must be the number of channels. The outputs array contains the vectors of the cartesian coordinates and the minimum size must be 6.
+         @param     inputs   The input vectors.
+         @param     outputs  The output vectors.
+         @param     frames   The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            for(ulong i = 0; i < frames; i++)
+            {
+                for(ulong j = 0; j < size; j++)
+                {
+                    m_vector[j] = inputs[j][i];
+                }
+                process(m_vector, m_vector + size);
+                for(ulong j = 0; j < 6ul; j++)
+                {
+                    outputs[j][i] = m_vector[size + j];
+                }
+            }
+        }
+
         //! This method compute the velocity vector.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and contains the channels samples and the minimum size must be the number of channels. The outputs array contains the vectors cartesian coordinates and the minimum size must be 3. The coordinates arrangement in the outputs array is velocity abscissa, velocity ordinate and velocity height.
          @param     inputs   The inputs array.
@@ -350,6 +350,7 @@ namespace hoa
         }
 
         vector<Point>       m_points;
+        vector<ulong>       m_triangles;
     public:
 
         Voronoi() noexcept
@@ -370,6 +371,7 @@ namespace hoa
         void clear()
         {
             m_points.clear();
+            m_triangles.clear();
         }
 
         vector<Point> const& getPoints() const noexcept
@@ -402,8 +404,17 @@ namespace hoa
             return m_points[i].neightbours;
         }
 
+        //! Get the triangles of the delaunay triangulation.
+        /** Get the indices of the points of the triangles computed by the last compute(), three indices per triangle. The indices after the added points refer to the point added at the bottom of the sphere. When more than three points lie on the same circle, only the fan of triangles from the point with the lowest index is kept, so the triangles never overlap.
+         */
+        vector<ulong> const& getTriangles() const noexcept
+        {
+            return m_triangles;
+        }
+
         void compute()
         {
+            m_triangles.clear();
             if(find_if(m_points.begin(), m_points.end(), onBottom) == m_points.end())
             {
                 m_points.push_back(Point(0., 0., -1.));
@@ -418,18 +429,35 @@ namespace hoa
                         if(t.r > 0.)
                         {
                             bool valid = true;
+                            bool fan   = true;
+                            const Point edge = m_points[k] - m_points[j];
+                            const double side = edge.cross(m_points[i] - m_points[j]).dot(t.p);
                             for(ulong l = 0; l < m_points.size(); l++)
                             {
                                 if(l != i && l != j && l != k)
                                 {
-                                    if(t.p.length(m_points[l]) < t.r - HOA_EPSILON)
+                                    const double distance = t.p.length(m_points[l]);
+                                    if(distance < t.r - HOA_EPSILON)
                                     {
                                         valid = false;
                                     }
+                                    else if(distance < t.r + HOA_EPSILON)
+                                    {
+                                        if(l < i || edge.cross(m_points[l] - m_points[j]).dot(t.p) * side < 0.)
+                                        {
+                                            fan = false;
+                                        }
+                                    }
                                 }
                             }
                             if(valid)
                             {
+                                if(fan)
+                                {
+                                    m_triangles.push_back(i);
+                                    m_triangles.push_back(j);
+                                    m_triangles.push_back(k);
+                                }
                                 m_points[i].addNeighbour(m_points[j]);
                                 m_points[i].addNeighbour(m_points[k]);
                                 m_points[i].addBound(t.p);
@@ -58,6 +58,14 @@ namespace hoa
          */
 		virtual void process(const T* inputs, T* outputs) noexcept = 0;
 
+        //! This method perform the widening.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The gains of the harmonics are computed when the widening changes and, if they changed since the previous vector, they are linearly interpolated over the vector so the widening can change once per vector without zipper noise.
+         @param     inputs	The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+		virtual void process(const T** inputs, T** outputs, const ulong frames) noexcept = 0;
+
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -65,9 +73,10 @@ namespace hoa
     template <typename T> class Wider<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
     {
     private:
-        T   m_widening;
-        T   m_gain;
-        T   m_factor;
+        T       m_widening;
+        T*      m_gains;
+        T*      m_previous;
+        bool    m_started;
     public:
 
         //! The wider constructor.
@@ -76,6 +85,9 @@ namespace hoa
          */
         Wider(const ulong order) noexcept : Processor<Hoa2d, T>::Harmonics(order)
         {
+            m_gains     = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_previous  = Signal<T>::alloc(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics());
+            m_started   = false;
             setWidening(1.);
         }
 
@@ -84,19 +96,26 @@ namespace hoa
          */
         ~Wider() noexcept
         {
-            ;
+            Signal<T>::free(m_gains);
+            Signal<T>::free(m_previous);
         }
 
         //! This method set the widening value.
-        /**	The the widening value is between \f$0\f$ and \f$1\f$. At \f$0\f$, the sound field is omni directional and at \f$1\f$ the sound field is intact.
+        /**	The the widening value is between \f$0\f$ and \f$1\f$. At \f$0\f$, the sound field is omni directional and at \f$1\f$ the sound field is intact. The gains of the harmonics are computed once here.
          @param     widening   The widening value.
          @see       setAzimuth()
          */
         inline void setWidening(const T widening) noexcept
         {
-            m_widening  = Math<T>::clip(widening, (T)0., (T)1.);
-            m_factor    = (1. - m_widening) * HOA_PI;
-            m_gain      = (sin(m_factor - HOA_PI2) + 1.) * 0.5;
+            const ulong order = Processor<Hoa2d, T>::Harmonics::getDecompositionOrder();
+            m_widening      = Math<T>::clip(widening, (T)0., (T)1.);
+            const T factor  = (1. - m_widening) * HOA_PI;
+            const T gain    = (sin(factor - HOA_PI2) + 1.) * 0.5;
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const ulong degree = Processor<Hoa2d, T>::Harmonics::getHarmonicDegree(i);
+                m_gains[i] = (cos(Math<T>::clip(factor * degree, 0., HOA_PI)) + 1.) * 0.5 * (gain * (order - degree) + 1.);
+            }
         }
 
         //! Get the the widening value.
@@ -115,29 +134,49 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) noexcept override
         {
-            T gain   = (m_gain * Processor<Hoa2d, T>::Harmonics::getDecompositionOrder());
-            T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
-
-            (*outputs++) = (*inputs++) * (gain + 1.);            // Hamonic [0,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,-1]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,1]
-            for(ulong i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            for(ulong i = 0; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
             {
-                gain    = (m_gain * (Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() - i) + 1.);
-                factor  = (cos(Math<T>::clip(m_factor * i, 0., HOA_PI)) + 1.) * 0.5 ;
+                outputs[i] = inputs[i] * m_gains[i];
+            }
+        }
 
-                (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i,-i]
-                (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i,i]
+        //! This method perform the widening.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The gains of the harmonics are computed when the widening changes and, if they changed since the previous vector, they are linearly interpolated over the vector so the widening can change once per vector without zipper noise.
+         @param     inputs	The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(m_started && memcmp(m_gains, m_previous, size * sizeof(T)))
+            {
+                const T step = T(1.) / T(frames);
+                for(ulong i = 0; i < size; i++)
+                {
+                    const T delta = (m_gains[i] - m_previous[i]) * step;
+                    Signal<T>::ramp(frames, m_previous[i] + delta, delta, inputs[i], outputs[i]);
+                }
             }
+            else
+            {
+                for(ulong i = 0; i < size; i++)
+                {
+                    Signal<T>::scale(frames, m_gains[i], inputs[i], outputs[i]);
+                }
+            }
+            Signal<T>::copy(size, m_gains, m_previous);
+            m_started = true;
         }
     };
 
     template <typename T> class Wider<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
     {
     private:
-        T   m_widening;
-        T   m_gain;
-        T   m_factor;
+        T       m_widening;
+        T*      m_gains;
+        T*      m_previous;
+        bool    m_started;
     public:
 
         //! The wider constructor.
@@ -146,6 +185,9 @@ namespace hoa
          */
         Wider(const ulong order) noexcept : Processor<Hoa3d, T>::Harmonics(order)
         {
+            m_gains     = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
+            m_previous  = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
+            m_started   = false;
             setWidening(1.);
         }
 
@@ -154,19 +196,26 @@ namespace hoa
          */
         ~Wider() noexcept
         {
-            ;
+            Signal<T>::free(m_gains);
+            Signal<T>::free(m_previous);
         }
 
         //! This method set the widening value.
-        /**	The widening value is between \f$0\f$ and \f$1\f$. At \f$0\f$, the sound field is omni directional and at \f$1\f$ the sound field is intact.
+        /**	The widening value is between \f$0\f$ and \f$1\f$. At \f$0\f$, the sound field is omni directional and at \f$1\f$ the sound field is intact. The gains of the harmonics are computed once here.
          @param     radius   The radius.
          @see       setAzimuth()
          */
         inline void setWidening(const T radius) noexcept
         {
-            m_widening  = Math<T>::clip(radius, (T)0., (T)1.);
-            m_factor    = (1. - m_widening) * HOA_PI;
-            m_gain      = (sin(m_factor - HOA_PI2) + 1.) * 0.5;
+            const ulong order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            m_widening      = Math<T>::clip(radius, (T)0., (T)1.);
+            const T factor  = (1. - m_widening) * HOA_PI;
+            const T gain    = (sin(factor - HOA_PI2) + 1.) * 0.5;
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const ulong degree = Processor<Hoa3d, T>::Harmonics::getHarmonicDegree(i);
+                m_gains[i] = (cos(Math<T>::clip(factor * degree, 0., HOA_PI)) + 1.) * 0.5 * (gain * (order - degree) + 1.);
+            }
         }
 
         //! Get the the widening value.
@@ -185,23 +234,39 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) noexcept override
         {
-            T gain   = (m_gain * Processor<Hoa3d, T>::Harmonics::getDecompositionOrder());
-            T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
-
-            (*outputs++) = (*inputs++) * (gain + 1.);            // Hamonic [0,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,-1]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,1]
-            for(ulong i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
+            for(ulong i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
             {
-                gain    = (m_gain * (Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() - i) + 1.);
-                factor  = (cos(Math<T>::clip(m_factor * i, 0., HOA_PI)) + 1.) * 0.5 ;
+                outputs[i] = inputs[i] * m_gains[i];
+            }
+        }
 
-                for(ulong j = 0; j < 2 * i + 1; j++)
+        //! This method perform the widening.
+        /**	You should use this method for in-place or not-in-place processing and vector by vector. The inputs and outputs array contains the vectors of the harmonics and the minimum size must be the number of harmonics. The gains of the harmonics are computed when the widening changes and, if they changed since the previous vector, they are linearly interpolated over the vector so the widening can change once per vector without zipper noise.
+         @param     inputs	The input vectors.
+         @param     outputs The output vectors.
+         @param     frames  The number of samples of the vectors.
+         */
+        inline void process(const T** inputs, T** outputs, const ulong frames) noexcept override
+        {
+            const ulong size = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(m_started && memcmp(m_gains, m_previous, size * sizeof(T)))
+            {
+                const T step = T(1.) / T(frames);
+                for(ulong i = 0; i < size; i++)
+                {
+                    const T delta = (m_gains[i] - m_previous[i]) * step;
+                    Signal<T>::ramp(frames, m_previous[i] + delta, delta, inputs[i], outputs[i]);
+                }
+            }
+            else
+            {
+                for(ulong i = 0; i < size; i++)
                 {
-                    (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i, ~j]
+                    Signal<T>::scale(frames, m_gains[i], inputs[i], outputs[i]);
                 }
             }
+            Signal<T>::copy(size, m_gains, m_previous);
+            m_started = true;
         }
     };
 